@@ -1,5 +1,7 @@
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <array>
 #include <vector>
 #include <map>
 #include <random>
@@ -8,17 +10,177 @@
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
 
 #ifdef _WIN32
     #include <windows.h>
-    void clearScreen() {
-        system("cls");
-    }
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/ioctl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Read-only view of a whole file: memory-mapped where the platform allows
+// it, otherwise read into memory.
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+
+public:
+    explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        bytes = buffer.data();
+        length = buffer.size();
 #else
-    void clearScreen() {
-        system("clear");
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                bytes = static_cast<const char*>(mapped);
+                length = static_cast<size_t>(info.st_size);
+            }
+        } else if (fstat(fd, &info) == 0) {
+            bytes = ""; // empty file: open, but nothing to map
+        }
+        close(fd);
+#endif
     }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (bytes && length > 0) munmap(const_cast<char*>(bytes), length);
 #endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return bytes != nullptr; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+using SkillId = int;
+
+// Core meeting skills, registered in name order so that their IDs are
+// stable and serialization keeps its historical ordering.
+enum CoreSkill : SkillId {
+    COMMUNICATION = 0,
+    LEADERSHIP = 1,
+    PRESENTATION = 2,
+    PROBLEM_SOLVING = 3,
+    TEAMWORK = 4,
+    CORE_SKILL_COUNT = 5
+};
+
+// Resolves skill names to dense integer IDs. Names are interned once, when
+// tasks are built or saves are parsed; everything after that works on IDs.
+class SkillRegistry {
+private:
+    std::deque<std::string> names; // deque keeps name references stable
+    std::map<std::string, SkillId> ids;
+    mutable std::mutex mutex;
+
+    SkillRegistry() {
+        intern("Communication");
+        intern("Leadership");
+        intern("Presentation");
+        intern("Problem_Solving");
+        intern("Teamwork");
+    }
+
+public:
+    static SkillRegistry& instance() {
+        static SkillRegistry registry;
+        return registry;
+    }
+
+    SkillId intern(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        SkillId id = static_cast<SkillId>(names.size());
+        names.push_back(name);
+        ids.emplace(name, id);
+        return id;
+    }
+
+    // Returns -1 for a name that has never been interned.
+    SkillId find(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(name);
+        return (it != ids.end()) ? it->second : -1;
+    }
+
+    // The reference stays valid as names are added: a deque never moves
+    // its elements, though growing it moves the map that indexes them.
+    const std::string& name(SkillId id) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return names[id];
+    }
+
+    int size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<int>(names.size());
+    }
+};
+
+inline const std::string& skillName(SkillId id) {
+    return SkillRegistry::instance().name(id);
+}
+
+// Skill IDs by name, remembered so that code reading many names, such as
+// each thread of a save file loader, takes the registry's lock once per
+// distinct name. With internNew false, names the registry has never seen
+// come back as -1 instead of being registered, and are listed in unknown()
+// in the order they were first looked up.
+class SkillNameCache {
+private:
+    std::map<std::string, SkillId, std::less<>> known;
+    std::vector<std::string> unknownNames;
+    bool internNew;
+
+public:
+    explicit SkillNameCache(bool internNewNames = true) : internNew(internNewNames) {}
+
+    SkillId lookup(std::string_view name) {
+        auto it = known.find(name);
+        if (it != known.end()) return it->second;
+        const std::string key(name);
+        const SkillId id = internNew ? SkillRegistry::instance().intern(key)
+                                     : SkillRegistry::instance().find(key);
+        known.emplace(key, id);
+        if (id < 0) unknownNames.push_back(key);
+        return id;
+    }
+
+    const std::vector<std::string>& unknown() const { return unknownNames; }
+};
 
 enum class JobLevel {
     INTERN = 0,
@@ -30,33 +192,429 @@ enum class JobLevel {
     FELLOW = 6
 };
 
+// Everything the engine reports. The meaning of the event fields for each
+// type is listed next to it; unused fields are empty or zero.
+enum class EventType : uint8_t {
+    // Character progression (subject = character name)
+    LEVELED_UP,                  // values[0] = new level
+    PROMOTION_ELIGIBLE,          // values[0] = JobLevel on offer
+    PROMOTED,                    // values[0] = new JobLevel
+    PROMOTION_BONUS,             // values[0] = XP, values[1] = skill points
+    SKILLS_DECAYING,             // values[0] = days inactive
+    SKILL_DECAYED,               // detail = skill, values[0] = new value
+    SKILL_IMPROVED,              // detail = skill, values[0] = points, values[1] = new value
+    // Roster
+    CHARACTER_JOINED,            // subject = name
+    CHARACTER_LEFT,              // subject = name
+    CREATION_CANCELLED,
+    // Team activities
+    NO_ACTIVITIES_LEFT,          // subject = name
+    ACTIVITY_STARTED,            // detail = task name
+    PARTICIPANT,                 // subject = name, values[0] = position, values[1] = team size
+    TEAM_BONUS,                  // values[0] = bonus
+    TASK_ROLL,                   // subject, detail = skill, values = roll, skill, team bonus, difficulty
+    TASK_SUCCEEDED,              // subject = name
+    TASK_FAILED,                 // subject = name, values[0] = consolation XP
+    TEAM_XP_BONUS,
+    // Promotion attempts
+    NOT_ELIGIBLE,                // subject = name
+    AT_MAX_LEVEL,                // subject = name
+    PROMOTION_ATTEMPT,           // subject = name, detail = task name, text = task description
+    PROMOTION_REQUIREMENT,       // detail = skill, values[0] = current, values[1] = required
+    PROMOTION_REQUIREMENTS_UNMET,
+    PROMOTION_ROLL,              // values = roll, skill bonus, difficulty
+    PROMOTION_ROLL_FAILED,
+    // Calendar and persistence
+    DAY_STARTED,                 // values[0] = day
+    ACTIVITIES_REFRESHED,
+    GAME_SAVED,                  // subject = file name
+    GAME_LOADED,                 // subject = file name, values[0] = day, values[1] = roster size
+    ERROR                        // text = message
+};
+
+struct GameEvent {
+    EventType type;
+    std::string_view subject;
+    std::string_view detail;
+    std::string_view text;
+    int values[4];
+};
+
+// Receives the engine's events. Sinks that discard everything construct the
+// base as disabled; emitters check isEnabled() first, so with such a sink no
+// event is even built, let alone formatted.
+class EventSink {
+private:
+    bool enabled;
+
+public:
+    explicit EventSink(bool isOn = true) : enabled(isOn) {}
+    virtual ~EventSink() = default;
+
+    bool isEnabled() const { return enabled; }
+    virtual void onEvent(const GameEvent& event) = 0;
+    virtual void flush() {}
+};
+
+class NullSink : public EventSink {
+public:
+    NullSink() : EventSink(false) {}
+    void onEvent(const GameEvent&) override {}
+};
+
+EventSink& nullSink() {
+    static NullSink sink;
+    return sink;
+}
+
+EventSink& consoleSink();
+
+// Engine instrumentation, exported in Prometheus text format. Build with
+// -DSDEWG_NO_METRICS to compile all of it out: every recording site is
+// wrapped in SDEWG_METRICS_ONLY(), which then expands to nothing.
+#ifndef SDEWG_NO_METRICS
+#define SDEWG_METRICS_ONLY(...) __VA_ARGS__
+
+class Metrics {
+public:
+    enum Operation {
+        ATTEMPT_TASK,
+        ATTEMPT_TASK_BATCH,
+        NEXT_DAY,
+        SAVE_GAME,
+        LOAD_GAME,
+        OPERATION_COUNT
+    };
+
+    enum PromotionOutcome {
+        PROMOTED,
+        ROLL_FAILED,
+        REQUIREMENTS_UNMET,
+        OUTCOME_COUNT
+    };
+
+    static const int MAX_TASKS = 64; // later tasks share the last counters
+    static const int LEVEL_COUNT = static_cast<int>(JobLevel::FELLOW) + 1;
+
+private:
+    // Written only by the owning thread, so a relaxed load and store (no
+    // locked read-modify-write) is enough, and the exporter can read it at
+    // any time without a data race.
+    struct Counter {
+        std::atomic<int64_t> value{0};
+        void add(int64_t n = 1) {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+        int64_t get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    // Buckets for values <= each bound, then one for everything above.
+    template <size_t N>
+    struct Histogram {
+        Counter buckets[N + 1];
+        Counter count;
+        Counter sum;
+
+        void observe(const int64_t (&bounds)[N], int64_t value) {
+            size_t bucket = 0;
+            while (bucket < N && value > bounds[bucket]) ++bucket;
+            buckets[bucket].add();
+            count.add();
+            sum.add(value);
+        }
+
+        void addTo(Histogram& total) const {
+            for (size_t i = 0; i <= N; ++i) total.buckets[i].add(buckets[i].get());
+            total.count.add(count.get());
+            total.sum.add(sum.get());
+        }
+    };
+
+    static constexpr int64_t MARGIN_BOUNDS[9] = {-20, -15, -10, -5, 0, 5, 10, 15, 20};
+    static constexpr int64_t DECAY_BOUNDS[7] = {1, 2, 3, 7, 14, 30, 90};
+    static constexpr int64_t LATENCY_BOUNDS_NS[8] = {1000, 10000, 100000, 1000000,
+                                                     10000000, 100000000, 1000000000, 10000000000};
+
+    // One thread's metrics.
+    struct Shard {
+        Counter taskAttempts[MAX_TASKS];
+        Counter taskSuccesses[MAX_TASKS];
+        Histogram<9> rollMargin;
+        Counter promotions[LEVEL_COUNT][OUTCOME_COUNT];
+        Histogram<7> decaySteps;
+        Histogram<8> latency[OPERATION_COUNT];
+
+        void addTo(Shard& total) const {
+            for (int t = 0; t < MAX_TASKS; ++t) {
+                total.taskAttempts[t].add(taskAttempts[t].get());
+                total.taskSuccesses[t].add(taskSuccesses[t].get());
+            }
+            rollMargin.addTo(total.rollMargin);
+            for (int l = 0; l < LEVEL_COUNT; ++l) {
+                for (int o = 0; o < OUTCOME_COUNT; ++o) total.promotions[l][o].add(promotions[l][o].get());
+            }
+            decaySteps.addTo(total.decaySteps);
+            for (int op = 0; op < OPERATION_COUNT; ++op) latency[op].addTo(total.latency[op]);
+        }
+    };
+
+    // Every thread's shard; those of exited threads are folded into retired.
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Shard*> live;
+        Shard retired;
+        std::vector<std::string> taskNames;
+    };
+
+    static Registry& registry() {
+        static Registry* instance = new Registry(); // outlives thread_local shards
+        return *instance;
+    }
+
+    struct LocalShard {
+        Shard* shard = new Shard();
+        LocalShard() {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            registry().live.push_back(shard);
+        }
+        ~LocalShard() {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            shard->addTo(r.retired);
+            r.live.erase(std::find(r.live.begin(), r.live.end(), shard));
+            delete shard;
+        }
+    };
+
+    static Shard& local() {
+        thread_local LocalShard holder;
+        return *holder.shard;
+    }
+
+    static std::string escape(const std::string& label) {
+        std::string escaped;
+        for (char c : label) {
+            if (c == '\\' || c == '"') escaped += '\\';
+            if (c == '\n') {
+                escaped += "\\n";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    // Integers as they are, anything scaled (e.g. ns to seconds) with
+    // enough digits to keep nanoseconds.
+    static void writeValue(std::ostream& out, int64_t value, double scale) {
+        if (scale == 1.0) {
+            out << value;
+        } else {
+            std::ostringstream text;
+            text << std::setprecision(15) << value * scale;
+            out << text.str();
+        }
+    }
+
+    template <size_t N>
+    static void writeHistogram(std::ostream& out, const char* name, const std::string& labels,
+                               const Histogram<N>& histogram, const int64_t (&bounds)[N], double scale) {
+        const std::string prefix = labels.empty() ? "{" : "{" + labels + ",";
+        int64_t cumulative = 0;
+        for (size_t i = 0; i <= N; ++i) {
+            cumulative += histogram.buckets[i].get();
+            out << name << "_bucket" << prefix << "le=\"";
+            if (i < N) {
+                writeValue(out, bounds[i], scale);
+            } else {
+                out << "+Inf";
+            }
+            out << "\"} " << cumulative << "\n";
+        }
+        const std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+        out << name << "_sum" << suffix << " ";
+        writeValue(out, histogram.sum.get(), scale);
+        out << "\n";
+        out << name << "_count" << suffix << " " << histogram.count.get() << "\n";
+    }
+
+public:
+    static void taskAttempted(int task, int participants, int successes) {
+        Shard& shard = local();
+        task = std::min(task, MAX_TASKS - 1);
+        shard.taskAttempts[task].add(participants);
+        shard.taskSuccesses[task].add(successes);
+    }
+
+    // Roll plus bonuses minus difficulty.
+    static void rollMargin(int margin) { local().rollMargin.observe(MARGIN_BOUNDS, margin); }
+
+    static void promotionAttempted(JobLevel level, PromotionOutcome outcome) {
+        local().promotions[static_cast<int>(level)][outcome].add();
+    }
+
+    // One decay event covering the given number of days' decay.
+    static void skillsDecayed(int steps) { local().decaySteps.observe(DECAY_BOUNDS, steps); }
+
+    static void operationTook(Operation operation, std::chrono::steady_clock::duration elapsed) {
+        local().latency[operation].observe(
+            LATENCY_BOUNDS_NS, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    // Label for a task index's counters, e.g. from the catalog in use.
+    static void nameTask(int task, const std::string& name) {
+        if (task < 0 || task >= MAX_TASKS) return;
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (static_cast<int>(r.taskNames.size()) <= task) r.taskNames.resize(task + 1);
+        if (r.taskNames[task] != name) r.taskNames[task] = name;
+    }
+
+    // Records how long the enclosing scope took.
+    class Timer {
+    private:
+        Operation operation;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit Timer(Operation op) : operation(op), start(std::chrono::steady_clock::now()) {}
+        ~Timer() { operationTook(operation, std::chrono::steady_clock::now() - start); }
+    };
+
+    // Writes the totals over every thread so far.
+    static void writePrometheus(std::ostream& out) {
+        static const char* const OPERATION_LABELS[OPERATION_COUNT] = {
+            "attempt_task_multiple", "attempt_task_batch", "next_day", "save_game", "load_game"};
+        static const char* const OUTCOME_LABELS[OUTCOME_COUNT] = {
+            "promoted", "roll_failed", "requirements_unmet"};
+        static const char* const LEVEL_LABELS[LEVEL_COUNT] = {
+            "intern", "engineer_1", "engineer_2", "senior_engineer",
+            "principal_engineer", "distinguished_engineer", "fellow"};
+
+        Shard total;
+        std::vector<std::string> taskNames;
+        {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.retired.addTo(total);
+            for (const Shard* shard : r.live) shard->addTo(total);
+            taskNames = r.taskNames;
+        }
+
+        out << "# HELP sdewg_task_attempts_total Participants who attempted a meeting task.\n"
+            << "# TYPE sdewg_task_attempts_total counter\n";
+        for (int t = 0; t < MAX_TASKS; ++t) {
+            if (total.taskAttempts[t].get() == 0) continue;
+            const std::string name = t < static_cast<int>(taskNames.size()) && !taskNames[t].empty()
+                                         ? taskNames[t] : std::to_string(t + 1);
+            out << "sdewg_task_attempts_total{task=\"" << escape(name) << "\"} "
+                << total.taskAttempts[t].get() << "\n";
+        }
+        out << "# HELP sdewg_task_successes_total Participants who succeeded at a meeting task.\n"
+            << "# TYPE sdewg_task_successes_total counter\n";
+        for (int t = 0; t < MAX_TASKS; ++t) {
+            if (total.taskAttempts[t].get() == 0) continue;
+            const std::string name = t < static_cast<int>(taskNames.size()) && !taskNames[t].empty()
+                                         ? taskNames[t] : std::to_string(t + 1);
+            out << "sdewg_task_successes_total{task=\"" << escape(name) << "\"} "
+                << total.taskSuccesses[t].get() << "\n";
+        }
+
+        out << "# HELP sdewg_roll_margin Task roll plus bonuses minus difficulty.\n"
+            << "# TYPE sdewg_roll_margin histogram\n";
+        writeHistogram(out, "sdewg_roll_margin", "", total.rollMargin, MARGIN_BOUNDS, 1.0);
+
+        out << "# HELP sdewg_promotion_attempts_total Promotion attempts by current job level and outcome.\n"
+            << "# TYPE sdewg_promotion_attempts_total counter\n";
+        for (int l = 0; l < LEVEL_COUNT; ++l) {
+            for (int o = 0; o < OUTCOME_COUNT; ++o) {
+                out << "sdewg_promotion_attempts_total{level=\"" << LEVEL_LABELS[l] << "\",outcome=\""
+                    << OUTCOME_LABELS[o] << "\"} " << total.promotions[l][o].get() << "\n";
+            }
+        }
+
+        out << "# HELP sdewg_skill_decay_days Days of skill decay applied per decay event.\n"
+            << "# TYPE sdewg_skill_decay_days histogram\n";
+        writeHistogram(out, "sdewg_skill_decay_days", "", total.decaySteps, DECAY_BOUNDS, 1.0);
+
+        out << "# HELP sdewg_operation_seconds Latency of engine operations.\n"
+            << "# TYPE sdewg_operation_seconds histogram\n";
+        for (int op = 0; op < OPERATION_COUNT; ++op) {
+            writeHistogram(out, "sdewg_operation_seconds",
+                           std::string("operation=\"") + OPERATION_LABELS[op] + "\"",
+                           total.latency[op], LATENCY_BOUNDS_NS, 1e-9);
+        }
+    }
+
+    // Replaces the file atomically, so a scraper never sees half a dump.
+    static bool writePrometheus(const std::string& filename) {
+        const std::string temp = filename + ".tmp";
+        {
+            std::ofstream file(temp);
+            if (!file.is_open()) return false;
+            writePrometheus(file);
+            if (!file) return false;
+        }
+        return std::rename(temp.c_str(), filename.c_str()) == 0;
+    }
+};
+
+// Dumps the metrics to a file every interval from a background thread, and
+// once more when destroyed.
+class MetricsExporter {
+private:
+    std::string filename;
+    std::chrono::milliseconds interval;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread thread;
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+            Metrics::writePrometheus(filename);
+        }
+    }
+
+public:
+    MetricsExporter(const std::string& file, std::chrono::milliseconds period)
+        : filename(file), interval(period), thread(&MetricsExporter::loop, this) {}
+
+    ~MetricsExporter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        thread.join();
+        Metrics::writePrometheus(filename);
+    }
+};
+#else
+#define SDEWG_METRICS_ONLY(...)
+#endif
+
 class Character {
 private:
     std::string name;
-    std::map<std::string, int> skills;
+    std::vector<int> skills; // indexed by SkillId, 0 = skill not held
     int experience;
     int level;
     JobLevel jobLevel;
     bool eligibleForPromotion;
     int activitiesLeft;
     int daysSinceActivity;
-    static const int MAX_ACTIVITIES_PER_DAY = 3;
+    int syncedDay; // game day the state above reflects
+    uint32_t id;   // stable within a game, keys the character's dice rolls
+    EventSink* sink;
     static const int SKILL_DECAY_THRESHOLD = 7; // days
 
-    std::string getJobLevelName(JobLevel jl) const {
-        switch (jl) {
-            case JobLevel::INTERN: return "Intern";
-            case JobLevel::ENGINEER_1: return "Engineer 1";
-            case JobLevel::ENGINEER_2: return "Engineer 2";
-            case JobLevel::SENIOR_ENGINEER: return "Senior Engineer";
-            case JobLevel::PRINCIPAL_ENGINEER: return "Principal Engineer";
-            case JobLevel::DISTINGUISHED_ENGINEER: return "Distinguished Engineer";
-            case JobLevel::FELLOW: return "Fellow";
-            default: return "Unknown";
-        }
-    }
+public:
+    static const int MAX_ACTIVITIES_PER_DAY = 3;
 
-    int getPromotionRequirement(JobLevel jl) const {
+    // Total experience needed to become eligible for promotion out of a level
+    static int getPromotionRequirement(JobLevel jl) {
         switch (jl) {
             case JobLevel::INTERN: return 200;           // To Engineer 1
             case JobLevel::ENGINEER_1: return 500;       // To Engineer 2
@@ -68,30 +626,54 @@ private:
         }
     }
 
-public:
+    static std::string getJobLevelName(JobLevel jl) {
+        switch (jl) {
+            case JobLevel::INTERN: return "Intern";
+            case JobLevel::ENGINEER_1: return "Engineer 1";
+            case JobLevel::ENGINEER_2: return "Engineer 2";
+            case JobLevel::SENIOR_ENGINEER: return "Senior Engineer";
+            case JobLevel::PRINCIPAL_ENGINEER: return "Principal Engineer";
+            case JobLevel::DISTINGUISHED_ENGINEER: return "Distinguished Engineer";
+            case JobLevel::FELLOW: return "Fellow";
+            default: return "Unknown";
+        }
+    }
+
     Character(const std::string& n) : name(n), experience(0), level(1), 
                                      jobLevel(JobLevel::INTERN), eligibleForPromotion(false),
-                                     activitiesLeft(MAX_ACTIVITIES_PER_DAY), daysSinceActivity(0) {
+                                     activitiesLeft(MAX_ACTIVITIES_PER_DAY), daysSinceActivity(0),
+                                     syncedDay(1), id(0), sink(&consoleSink()) {
         // Initialize core meeting skills
-        skills["Leadership"] = 1;
-        skills["Communication"] = 1;
-        skills["Problem_Solving"] = 1;
-        skills["Teamwork"] = 1;
-        skills["Presentation"] = 1;
+        skills.assign(CORE_SKILL_COUNT, 1);
     }
 
     const std::string& getName() const { return name; }
     int getLevel() const { return level; }
     int getExperience() const { return experience; }
     int getActivitiesLeft() const { return activitiesLeft; }
+    int getActivitiesUsedToday() const { return MAX_ACTIVITIES_PER_DAY - activitiesLeft; }
     int getDaysSinceActivity() const { return daysSinceActivity; }
     JobLevel getJobLevel() const { return jobLevel; }
     std::string getJobLevelString() const { return getJobLevelName(jobLevel); }
     bool isEligibleForPromotion() const { return eligibleForPromotion; }
+    uint32_t getId() const { return id; }
+    void setId(uint32_t characterId) { id = characterId; }
+    void setEventSink(EventSink& eventSink) { sink = &eventSink; }
+
+    void emit(EventType type, std::string_view detail = {}, int v0 = 0, int v1 = 0) const {
+        if (sink->isEnabled()) {
+            sink->onEvent(GameEvent{type, name, detail, {}, {v0, v1, 0, 0}});
+        }
+    }
     
+    const std::vector<int>& getSkills() const { return skills; }
+
+    int getSkill(SkillId skill) const {
+        return (skill >= 0 && skill < static_cast<SkillId>(skills.size())) ? skills[skill] : 0;
+    }
+
     int getSkill(const std::string& skill) const {
-        auto it = skills.find(skill);
-        return (it != skills.end()) ? it->second : 0;
+        return getSkill(SkillRegistry::instance().find(skill));
     }
 
     bool canDoActivity() const {
@@ -111,10 +693,7 @@ public:
         int requiredExp = getPromotionRequirement(jobLevel);
         if (experience >= requiredExp && !eligibleForPromotion) {
             eligibleForPromotion = true;
-            std::cout << "\n*** " << name << " is eligible for promotion to " 
-                      << getJobLevelName(static_cast<JobLevel>(static_cast<int>(jobLevel) + 1)) 
-                      << "! ***\n";
-            std::cout << "Complete a promotion task to advance!\n";
+            emit(EventType::PROMOTION_ELIGIBLE, {}, static_cast<int>(jobLevel) + 1);
         }
     }
 
@@ -126,37 +705,55 @@ public:
         jobLevel = static_cast<JobLevel>(static_cast<int>(jobLevel) + 1);
         eligibleForPromotion = false;
         
-        std::cout << "\n🎉 PROMOTION! " << name << " is now a " 
-                  << getJobLevelName(jobLevel) << "! 🎉\n";
+        emit(EventType::PROMOTED, {}, static_cast<int>(jobLevel));
         
         // Promotion bonus
         gainExperience(100);
-        for (auto& skill : skills) {
-            skill.second += 1;
+        for (int& value : skills) {
+            if (value > 0) value += 1;
         }
-        std::cout << "Promotion bonus: +100 XP and +1 to all skills!\n";
+        emit(EventType::PROMOTION_BONUS, {}, 100, 1);
         
         return true;
     }
 
+    int getSyncedDay() const { return syncedDay; }
+
+    // Marks the character's state as current on the given day, e.g. when
+    // it joins the game or is loaded from a save made on that day.
+    void startOnDay(int day) { syncedDay = day; }
+
     void newDay() {
+        advanceTo(syncedDay + 1);
+    }
+
+    // Brings the character forward to a later game day in O(skills),
+    // however many days that skips. Activities are refreshed and skills
+    // decay exactly as if newDay() had run once per day: one step for
+    // every day on which the inactivity count is at or past the threshold.
+    void advanceTo(int day) {
+        const int days = day - syncedDay;
+        if (days <= 0) return;
+        syncedDay = day;
         activitiesLeft = MAX_ACTIVITIES_PER_DAY;
-        daysSinceActivity++;
-        
-        // Apply skill decay if inactive too long
-        if (daysSinceActivity >= SKILL_DECAY_THRESHOLD) {
-            applySkillDecay();
+        const int decayDays = std::min(days, daysSinceActivity + days - (SKILL_DECAY_THRESHOLD - 1));
+        daysSinceActivity += days;
+        if (decayDays > 0) {
+            decaySkills(decayDays);
         }
     }
 
     void applySkillDecay() {
-        std::cout << name << " has been inactive for " << daysSinceActivity 
-                  << " days. Skills are decaying!\n";
-        for (auto& skill : skills) {
-            if (skill.second > 1) {
-                skill.second--;
-                std::cout << name << "'s " << skill.first << " decreased to " 
-                          << skill.second << "\n";
+        decaySkills(1);
+    }
+
+    void decaySkills(int steps) {
+        SDEWG_METRICS_ONLY(Metrics::skillsDecayed(steps);)
+        emit(EventType::SKILLS_DECAYING, {}, daysSinceActivity);
+        for (SkillId id = 0; id < static_cast<SkillId>(skills.size()); ++id) {
+            if (skills[id] > 1) {
+                skills[id] = std::max(1, skills[id] - steps);
+                emit(EventType::SKILL_DECAYED, skillName(id), skills[id]);
             }
         }
     }
@@ -166,15 +763,33 @@ public:
         int newLevel = 1 + (experience / 100);
         if (newLevel > level) {
             level = newLevel;
-            std::cout << name << " leveled up to level " << level << "!\n";
+            emit(EventType::LEVELED_UP, {}, level);
         }
         checkPromotionEligibility();
     }
 
-    void improveSkill(const std::string& skill, int points) {
+    void improveSkill(SkillId skill, int points) {
+        if (skill >= static_cast<SkillId>(skills.size())) {
+            skills.resize(skill + 1, 0);
+        }
         skills[skill] += points;
-        std::cout << name << "'s " << skill << " improved by " << points 
-                  << " (now " << skills[skill] << ")\n";
+        emit(EventType::SKILL_IMPROVED, skillName(skill), points, skills[skill]);
+    }
+
+    void improveSkill(const std::string& skill, int points) {
+        improveSkill(SkillRegistry::instance().intern(skill), points);
+    }
+
+    // Overwrites the progression state wholesale, e.g. from a save file.
+    void restoreState(int exp, int lvl, JobLevel jl, bool eligible,
+                      int activities, int daysInactive, std::vector<int> skillValues) {
+        experience = exp;
+        level = lvl;
+        jobLevel = jl;
+        eligibleForPromotion = eligible;
+        activitiesLeft = activities;
+        daysSinceActivity = daysInactive;
+        skills = std::move(skillValues);
     }
 
     // Serialization methods for saving/loading
@@ -185,57 +800,89 @@ public:
            << "|" << activitiesLeft << "|" << daysSinceActivity << "|";
         
         // Save skills
-        for (const auto& skill : skills) {
-            ss << skill.first << ":" << skill.second << ",";
+        for (SkillId id = 0; id < static_cast<SkillId>(skills.size()); ++id) {
+            if (skills[id] > 0) {
+                ss << skillName(id) << ":" << skills[id] << ",";
+            }
         }
         ss << "\n";
         return ss.str();
     }
 
-    static Character deserialize(const std::string& data) {
-        std::stringstream ss(data);
-        std::string token;
-        
-        // Parse basic data
-        std::getline(ss, token, '|');
-        Character character(token); // name
-        
-        std::getline(ss, token, '|');
-        character.experience = std::stoi(token);
-        
-        std::getline(ss, token, '|');
-        character.level = std::stoi(token);
-        
-        std::getline(ss, token, '|');
-        character.jobLevel = static_cast<JobLevel>(std::stoi(token));
-        
-        std::getline(ss, token, '|');
-        character.eligibleForPromotion = (std::stoi(token) == 1);
-        
-        std::getline(ss, token, '|');
-        character.activitiesLeft = std::stoi(token);
-        
-        std::getline(ss, token, '|');
-        character.daysSinceActivity = std::stoi(token);
-        
-        // Parse skills
-        std::getline(ss, token);
-        if (!token.empty() && token.back() == ',') {
-            token.pop_back(); // Remove trailing comma
+    // Reads a line written by serialize() into this character's saved
+    // state, in place, looking skill names up through skillIds; skills it
+    // does not know are checked but left out. Returns false and sets error
+    // if the line is malformed; the character is then partly overwritten.
+    bool parse(std::string_view line, SkillNameCache& skillIds, std::string& error) {
+        static const char* const FIELDS[] = {"experience", "level", "job level", "promotion eligibility",
+                                             "activities left", "days inactive"};
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.remove_suffix(1);
+
+        size_t bar = line.find('|');
+        if (bar == std::string_view::npos) {
+            error = "missing character fields";
+            return false;
         }
-        
-        character.skills.clear();
-        std::stringstream skillStream(token);
-        std::string skillPair;
-        while (std::getline(skillStream, skillPair, ',')) {
-            size_t colonPos = skillPair.find(':');
-            if (colonPos != std::string::npos) {
-                std::string skillName = skillPair.substr(0, colonPos);
-                int skillValue = std::stoi(skillPair.substr(colonPos + 1));
-                character.skills[skillName] = skillValue;
+        name.assign(line.data(), bar);
+
+        int values[6];
+        for (int field = 0; field < 6; ++field) {
+            const size_t start = bar + 1;
+            bar = line.find('|', start);
+            if (bar == std::string_view::npos) {
+                error = "missing character fields";
+                return false;
+            }
+            const auto parsed = std::from_chars(line.data() + start, line.data() + bar, values[field]);
+            if (parsed.ec != std::errc() || parsed.ptr != line.data() + bar) {
+                error = std::string("invalid ") + FIELDS[field];
+                return false;
             }
         }
-        
+        if (values[2] < 0 || values[2] > static_cast<int>(JobLevel::FELLOW)) {
+            error = "invalid job level";
+            return false;
+        }
+        experience = values[0];
+        level = values[1];
+        jobLevel = static_cast<JobLevel>(values[2]);
+        eligibleForPromotion = values[3] == 1;
+        activitiesLeft = values[4];
+        daysSinceActivity = values[5];
+
+        // Skills as name:value pairs, each followed by a comma
+        skills.clear();
+        skills.reserve(CORE_SKILL_COUNT);
+        for (std::string_view rest = line.substr(bar + 1); !rest.empty();) {
+            const size_t comma = std::min(rest.find(','), rest.size());
+            const std::string_view pair = rest.substr(0, comma);
+            rest.remove_prefix(std::min(comma + 1, rest.size()));
+            const size_t colon = pair.find(':');
+            if (colon == std::string_view::npos) continue;
+
+            const std::string_view skill = pair.substr(0, colon);
+            const SkillId id = skillIds.lookup(skill);
+            int value;
+            const auto parsed = std::from_chars(pair.data() + colon + 1, pair.data() + pair.size(), value);
+            if (parsed.ec != std::errc() || parsed.ptr != pair.data() + pair.size()) {
+                error = "invalid value for skill '" + std::string(skill) + "'";
+                return false;
+            }
+            if (id < 0) continue;
+            if (id >= static_cast<SkillId>(skills.size())) {
+                skills.resize(id + 1, 0);
+            }
+            skills[id] = value;
+        }
+        return true;
+    }
+
+    // Throws std::invalid_argument if the line is malformed.
+    static Character deserialize(const std::string& data) {
+        Character character("");
+        static thread_local SkillNameCache skillIds;
+        std::string error;
+        if (!character.parse(data, skillIds, error)) throw std::invalid_argument(error);
         return character;
     }
 
@@ -255,120 +902,3156 @@ public:
         std::cout << "Activities Left Today: " << activitiesLeft << "/" << MAX_ACTIVITIES_PER_DAY << "\n";
         std::cout << "Days Since Last Activity: " << daysSinceActivity << "\n";
         std::cout << "Skills:\n";
-        for (const auto& skill : skills) {
-            std::cout << "  " << std::setw(15) << skill.first << ": " << skill.second << "\n";
+        for (SkillId id = 0; id < static_cast<SkillId>(skills.size()); ++id) {
+            if (skills[id] > 0) {
+                std::cout << "  " << std::setw(15) << skillName(id) << ": " << skills[id] << "\n";
+            }
         }
     }
 };
 
-class PromotionTask {
-public:
-    std::string name;
-    std::string description;
-    JobLevel requiredLevel;
-    std::map<std::string, int> skillRequirements;
-    int difficulty;
+// Draws the interactive game's screens. While it exists it stands in for
+// the output stream's buffer: everything printed after beginFrame() makes
+// up one frame, drawn whenever the stream is flushed, which includes every
+// time input is read. A new frame is drawn over the last one with ANSI
+// cursor control, rewriting only the lines that differ, in one write.
+// Output that is not a terminal gets the frames as plain text, one after
+// another.
+class TerminalRenderer : public std::streambuf {
+private:
+    // Passes input through a line at a time, drawing the frame before
+    // each read and noting the line the terminal echoes.
+    class InputTap : public std::streambuf {
+    private:
+        TerminalRenderer& renderer;
+        std::streambuf* source;
+        std::string line;
 
-    PromotionTask(const std::string& n, const std::string& desc, JobLevel level, 
-                  const std::map<std::string, int>& skillReqs, int diff)
-        : name(n), description(desc), requiredLevel(level), 
-          skillRequirements(skillReqs), difficulty(diff) {}
-};
+    protected:
+        int_type underflow() override {
+            renderer.present();
+            line.clear();
+            for (int_type c; (c = source->sbumpc()) != traits_type::eof();) {
+                line += traits_type::to_char_type(c);
+                if (c == '\n') break;
+            }
+            if (line.empty()) return traits_type::eof();
+            renderer.echoed(line);
+            setg(&line[0], &line[0], &line[0] + line.size());
+            return traits_type::to_int_type(line[0]);
+        }
 
-class MeetingTask {
-public:
-    std::string name;
-    std::string description;
-    std::string requiredSkill;
-    int difficulty;
-    int expReward;
-    int skillReward;
+    public:
+        InputTap(TerminalRenderer& owner, std::streambuf* input) : renderer(owner), source(input) {}
+    };
 
-    MeetingTask(const std::string& n, const std::string& desc, 
-                const std::string& skill, int diff, int exp, int skillR)
-        : name(n), description(desc), requiredSkill(skill), 
-          difficulty(diff), expReward(exp), skillReward(skillR) {}
-};
+    static TerminalRenderer*& installed() {
+        static TerminalRenderer* renderer = nullptr;
+        return renderer;
+    }
 
-class MeetingGame {
-private:
-    std::vector<Character> characters;
-    std::vector<MeetingTask> tasks;
-    std::vector<PromotionTask> promotionTasks;
-    std::mt19937 rng;
-    std::uniform_int_distribution<int> dice;
-    int currentDay;
+    std::ostream& out;
+    std::istream& in;
+    std::streambuf* output; // the streams' own buffers
+    std::streambuf* input;
+    InputTap tap;
+    bool ansi = false; // output is a terminal
+    bool echo = false; // input is a terminal, which echoes what is typed
+    size_t height = 24;
+    size_t width = 80;
 
-public:
-    MeetingGame() : rng(std::random_device{}()), dice(1, 20), currentDay(1) {
-        initializeTasks();
-        initializePromotionTasks();
+    std::string frame;
+    size_t presented = 0; // bytes of frame already drawn
+    bool fresh = false;   // frame replaces the screen when next drawn
+    std::vector<std::string> screen; // rows as last drawn; the cursor is on the last
+    bool screenKnown = false;        // false once the terminal may have scrolled
+
+    // Follows text written at the cursor.
+    void track(std::string_view text) {
+        if (screen.empty()) screen.emplace_back();
+        for (char c : text) {
+            if (c == '\n') {
+                screen.emplace_back();
+            } else {
+                screen.back() += c;
+            }
+        }
+        screenKnown = screenKnown && screen.size() <= height && screen.back().size() < width;
     }
 
-    void initializePromotionTasks() {
-        // Intern -> Engineer 1
-        promotionTasks.emplace_back("Complete First Project", 
-            "Successfully deliver your first major project contribution",
-            JobLevel::INTERN, 
-            std::map<std::string, int>{{"Communication", 3}, {"Teamwork", 3}}, 15);
-        
+    void echoed(std::string_view line) {
+        if (ansi && echo) track(line);
+    }
+
+    // The escape sequences that turn the screen into the frame.
+    std::string redraw() {
+        std::vector<std::string> rows(1);
+        bool fits = true;
+        for (char c : frame) {
+            if (c == '\n') {
+                fits = fits && rows.back().size() < width;
+                rows.emplace_back();
+            } else {
+                rows.back() += c;
+            }
+        }
+        fits = fits && rows.size() <= height && rows.back().size() < width;
+
+        std::string text;
+        if (!fits || !screenKnown) {
+            // Too big to place line by line, or nothing to compare against
+            text = "\x1b[H\x1b[2J" + frame;
+        } else {
+            // The last row is always written, which leaves the cursor after it
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (i + 1 < rows.size() && i < screen.size() && screen[i] == rows[i]) continue;
+                text += "\x1b[" + std::to_string(i + 1) + ";1H";
+                text += rows[i];
+                text += "\x1b[K";
+            }
+            text += "\x1b[J";
+        }
+        screen = std::move(rows);
+        screenKnown = fits;
+        return text;
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (c != traits_type::eof()) frame += traits_type::to_char_type(c);
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        frame.append(s, static_cast<size_t>(n));
+        return n;
+    }
+
+    int sync() override {
+        present();
+        return 0;
+    }
+
+public:
+    TerminalRenderer(std::ostream& os, std::istream& is)
+        : out(os), in(is), output(os.rdbuf()), input(is.rdbuf()), tap(*this, is.rdbuf()) {
+#ifdef _WIN32
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        ansi = _isatty(_fileno(stdout)) && GetConsoleMode(console, &mode) &&
+               SetConsoleMode(console, mode | 0x0004); // ENABLE_VIRTUAL_TERMINAL_PROCESSING
+        echo = _isatty(_fileno(stdin));
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (ansi && GetConsoleScreenBufferInfo(console, &info)) {
+            height = info.srWindow.Bottom - info.srWindow.Top + 1;
+            width = info.srWindow.Right - info.srWindow.Left + 1;
+        }
+#else
+        ansi = isatty(STDOUT_FILENO);
+        echo = isatty(STDIN_FILENO);
+        winsize size;
+        if (ansi && ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+            height = size.ws_row;
+            width = size.ws_col;
+        }
+#endif
+        out.rdbuf(this);
+        in.rdbuf(&tap);
+        installed() = this;
+    }
+
+    ~TerminalRenderer() override {
+        present();
+        out.rdbuf(output);
+        in.rdbuf(input);
+        installed() = nullptr;
+    }
+
+    TerminalRenderer(const TerminalRenderer&) = delete;
+    TerminalRenderer& operator=(const TerminalRenderer&) = delete;
+
+    // The renderer drawing the game's screens, if one exists.
+    static TerminalRenderer* current() { return installed(); }
+
+    // Starts a new screen, drawn over the current one.
+    void beginFrame() {
+        if (!ansi || !fresh) present(); // a frame replaced before it was drawn is dropped
+        frame.clear();
+        presented = 0;
+        fresh = true;
+    }
+
+    // Draws what has been printed since the last time.
+    void present() {
+        if (presented == frame.size() && !fresh) return;
+        std::string text;
+        if (ansi && fresh) {
+            text = redraw();
+        } else {
+            text.assign(frame, presented, std::string::npos);
+            if (ansi) track(text);
+        }
+        fresh = false;
+        presented = frame.size();
+        output->sputn(text.data(), static_cast<std::streamsize>(text.size()));
+        output->pubsync();
+    }
+
+    // How many entries of linesPerEntry lines fit on a screen beside
+    // reservedLines of menu text; unlimited unless drawing a terminal.
+    int pageEntries(int linesPerEntry, int reservedLines) const {
+        if (!ansi) return std::numeric_limits<int>::max();
+        return std::max(1, (static_cast<int>(height) - reservedLines) / std::max(1, linesPerEntry));
+    }
+};
+
+// Starts a new screen of the interactive game; a no-op unless a
+// TerminalRenderer is drawing.
+inline void clearScreen() {
+    if (TerminalRenderer* renderer = TerminalRenderer::current()) {
+        renderer->beginFrame();
+    }
+}
+
+// Formats events as the game's familiar console text. Output is collected
+// in one buffer and written in large chunks; call flush() before reading
+// input so that the player sees everything.
+class ConsoleSink : public EventSink {
+private:
+    std::ostream& os;
+    std::string buffer;
+    static const size_t FLUSH_THRESHOLD = 64 * 1024;
+
+    void append(std::string_view str) { buffer.append(str.data(), str.size()); }
+    void append(int value) { buffer += std::to_string(value); }
+
+    template <typename First, typename Second, typename... Rest>
+    void append(const First& first, const Second& second, const Rest&... rest) {
+        append(first);
+        append(second, rest...);
+    }
+
+    static std::string_view jobLevelName(int level) {
+        static const std::string names[] = {
+            Character::getJobLevelName(JobLevel::INTERN),
+            Character::getJobLevelName(JobLevel::ENGINEER_1),
+            Character::getJobLevelName(JobLevel::ENGINEER_2),
+            Character::getJobLevelName(JobLevel::SENIOR_ENGINEER),
+            Character::getJobLevelName(JobLevel::PRINCIPAL_ENGINEER),
+            Character::getJobLevelName(JobLevel::DISTINGUISHED_ENGINEER),
+            Character::getJobLevelName(JobLevel::FELLOW)};
+        return (level >= 0 && level <= static_cast<int>(JobLevel::FELLOW)) ? std::string_view(names[level])
+                                                                           : std::string_view("Unknown");
+    }
+
+public:
+    explicit ConsoleSink(std::ostream& stream) : os(stream) {}
+    ~ConsoleSink() override { flush(); }
+
+    void flush() override {
+        if (buffer.empty()) return;
+        os.write(buffer.data(), buffer.size());
+        os.flush();
+        buffer.clear();
+    }
+
+    void onEvent(const GameEvent& e) override {
+        const int* v = e.values;
+        switch (e.type) {
+            case EventType::LEVELED_UP:
+                append(e.subject, " leveled up to level ", v[0], "!\n");
+                break;
+            case EventType::PROMOTION_ELIGIBLE:
+                append("\n*** ", e.subject, " is eligible for promotion to ", jobLevelName(v[0]), "! ***\n");
+                append("Complete a promotion task to advance!\n");
+                break;
+            case EventType::PROMOTED:
+                append("\n🎉 PROMOTION! ", e.subject, " is now a ", jobLevelName(v[0]), "! 🎉\n");
+                break;
+            case EventType::PROMOTION_BONUS:
+                append("Promotion bonus: +", v[0], " XP and +", v[1], " to all skills!\n");
+                break;
+            case EventType::SKILLS_DECAYING:
+                append(e.subject, " has been inactive for ", v[0], " days. Skills are decaying!\n");
+                break;
+            case EventType::SKILL_DECAYED:
+                append(e.subject, "'s ", e.detail, " decreased to ", v[0], "\n");
+                break;
+            case EventType::SKILL_IMPROVED:
+                append(e.subject, "'s ", e.detail, " improved by ", v[0], " (now ", v[1], ")\n");
+                break;
+            case EventType::CHARACTER_JOINED:
+                append(e.subject, " joined the meeting group!\n");
+                break;
+            case EventType::CHARACTER_LEFT:
+                append(e.subject, " has left the team.\n");
+                break;
+            case EventType::CREATION_CANCELLED:
+                append("Character creation cancelled.\n");
+                break;
+            case EventType::NO_ACTIVITIES_LEFT:
+                append(e.subject, " has no activities left today!\n");
+                break;
+            case EventType::ACTIVITY_STARTED:
+                append("\n=== Team Activity: ", e.detail, " ===\n", "Participants: ");
+                break;
+            case EventType::PARTICIPANT:
+                append(e.subject, v[0] + 1 < v[1] ? ", " : "\n\n");
+                break;
+            case EventType::TEAM_BONUS:
+                append("Team Collaboration Bonus: +", v[0], "\n");
+                break;
+            case EventType::TASK_ROLL:
+                append(e.subject, ": Roll ", v[0], " + ", e.detail, "(", v[1], ")");
+                if (v[2] > 0) append(" + Team(", v[2], ")");
+                append(" = ", v[0] + v[1] + v[2], " vs ", v[3], "\n");
+                break;
+            case EventType::TASK_SUCCEEDED:
+                append("  SUCCESS! ");
+                break;
+            case EventType::TASK_FAILED:
+                append("  FAILED! ", e.subject, " gains ", v[0], " XP for trying.\n");
+                break;
+            case EventType::TEAM_XP_BONUS:
+                append("\nTeam activity bonus XP granted to all participants!\n");
+                break;
+            case EventType::NOT_ELIGIBLE:
+                append(e.subject, " is not eligible for promotion yet!\n");
+                break;
+            case EventType::AT_MAX_LEVEL:
+                append(e.subject, " is already at the highest level!\n");
+                break;
+            case EventType::PROMOTION_ATTEMPT:
+                append("\n=== PROMOTION ATTEMPT ===\n", "Task: ", e.detail, "\n", e.text, "\n\n");
+                append("Skill Requirements Check:\n");
+                break;
+            case EventType::PROMOTION_REQUIREMENT:
+                append("  ", e.detail, ": ", v[0], "/", v[1], v[0] >= v[1] ? " ✓\n" : " ✗\n");
+                break;
+            case EventType::PROMOTION_REQUIREMENTS_UNMET:
+                append("\nFAILED! Skills not sufficient for promotion.\n");
+                break;
+            case EventType::PROMOTION_ROLL:
+                append("\nPromotion Roll: ", v[0], " + Skills(", v[1], ") = ", v[0] + v[1], " vs ", v[2], "\n");
+                break;
+            case EventType::PROMOTION_ROLL_FAILED:
+                append("FAILED! Not quite ready for promotion. Keep developing skills!\n");
+                break;
+            case EventType::DAY_STARTED:
+                append("=== Day ", v[0], " begins! ===\n");
+                break;
+            case EventType::ACTIVITIES_REFRESHED:
+                append("All team members have refreshed their daily activities.\n");
+                break;
+            case EventType::GAME_SAVED:
+                append("Game saved to '", e.subject, "'!\n");
+                break;
+            case EventType::GAME_LOADED:
+                append("Game loaded from '", e.subject, "'!\n");
+                append("Day ", v[0], " - ", v[1], " team members loaded.\n");
+                break;
+            case EventType::ERROR:
+                append(e.text, "\n");
+                break;
+        }
+        if (buffer.size() >= FLUSH_THRESHOLD) flush();
+    }
+};
+
+EventSink& consoleSink() {
+    static ConsoleSink sink(std::cout);
+    return sink;
+}
+
+// Writes events to a file as compact binary records for offline analysis:
+//   [u8 type][u16 subject len][u16 detail len][u16 text len][i32 values[4]]
+//   followed by the subject, detail and text bytes.
+class BinaryEventSink : public EventSink {
+private:
+    std::ofstream file;
+    std::string buffer;
+    static const size_t FLUSH_THRESHOLD = 1 << 20;
+
+    template <typename T>
+    void put(T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+public:
+    explicit BinaryEventSink(const std::string& filename)
+        : file(filename, std::ios::binary | std::ios::trunc) {}
+    ~BinaryEventSink() override { flush(); }
+
+    bool isOpen() const { return file.is_open(); }
+
+    void flush() override {
+        if (buffer.empty()) return;
+        file.write(buffer.data(), buffer.size());
+        file.flush();
+        buffer.clear();
+    }
+
+    void onEvent(const GameEvent& e) override {
+        const std::string_view strings[] = {e.subject.substr(0, UINT16_MAX), e.detail.substr(0, UINT16_MAX),
+                                            e.text.substr(0, UINT16_MAX)};
+        put<uint8_t>(static_cast<uint8_t>(e.type));
+        for (std::string_view str : strings) put<uint16_t>(static_cast<uint16_t>(str.size()));
+        for (int value : e.values) put<int32_t>(value);
+        for (std::string_view str : strings) buffer.append(str.data(), str.size());
+        if (buffer.size() >= FLUSH_THRESHOLD) flush();
+    }
+};
+
+// Compile-time descriptions of catalog entries, for the built-in catalog.
+struct MeetingTaskSpec {
+    std::string_view name;
+    std::string_view description;
+    std::string_view skill;
+    int difficulty;
+    int expReward;
+    int skillReward;
+};
+
+struct PromotionTaskSpec {
+    static const int MAX_REQUIREMENTS = 4;
+
+    std::string_view name;
+    std::string_view description;
+    JobLevel requiredLevel;
+    int difficulty;
+    int requirementCount;
+    std::array<std::pair<std::string_view, int>, MAX_REQUIREMENTS> requirements;
+};
+
+class PromotionTask {
+public:
+    std::string name;
+    std::string description;
+    JobLevel requiredLevel;
+    std::vector<std::pair<SkillId, int>> skillRequirements;
+    int difficulty;
+
+    PromotionTask(const std::string& n, const std::string& desc, JobLevel level, 
+                  const std::map<std::string, int>& skillReqs, int diff)
+        : name(n), description(desc), requiredLevel(level), difficulty(diff) {
+        for (const auto& req : skillReqs) {
+            skillRequirements.emplace_back(SkillRegistry::instance().intern(req.first), req.second);
+        }
+    }
+
+    explicit PromotionTask(const PromotionTaskSpec& spec)
+        : name(spec.name), description(spec.description), requiredLevel(spec.requiredLevel),
+          difficulty(spec.difficulty) {
+        for (int i = 0; i < spec.requirementCount; ++i) {
+            const auto& req = spec.requirements[i];
+            skillRequirements.emplace_back(SkillRegistry::instance().intern(std::string(req.first)), req.second);
+        }
+    }
+};
+
+class MeetingTask {
+public:
+    std::string name;
+    std::string description;
+    SkillId requiredSkill;
+    int difficulty;
+    int expReward;
+    int skillReward;
+
+    MeetingTask(const std::string& n, const std::string& desc, 
+                const std::string& skill, int diff, int exp, int skillR)
+        : name(n), description(desc), requiredSkill(SkillRegistry::instance().intern(skill)), 
+          difficulty(diff), expReward(exp), skillReward(skillR) {}
+
+    explicit MeetingTask(const MeetingTaskSpec& spec)
+        : MeetingTask(std::string(spec.name), std::string(spec.description), std::string(spec.skill),
+                      spec.difficulty, spec.expReward, spec.skillReward) {}
+};
+
+enum class SaveFormat {
+    TEXT_V1,   // SDEWG_SAVE_v1.0: one pipe-delimited line per character
+    BINARY_V2, // SDEWG_SAVE_v2: fixed-size records, loaded through mmap
+    JOURNALED  // SDEWG_SAVE_v2 snapshot plus an append-only delta journal
+};
+
+// The meeting tasks and promotion tasks a game is played with. Promotion
+// tasks are indexed by the JobLevel they promote from and meeting tasks by
+// the skill they train, so every lookup on the activity and promotion
+// paths is constant-time however large the catalog is.
+//
+// Catalog files are line-oriented and pipe-delimited like save files:
+//   task|<name>|<description>|<skill>|<difficulty>|<xp reward>|<skill reward>
+//   promotion|<name>|<description>|<from JobLevel 0-5>|<difficulty>|<skill>:<min>,...
+// Blank lines and lines starting with '#' are ignored.
+class TaskCatalog {
+private:
+    static const int LEVEL_COUNT = static_cast<int>(JobLevel::FELLOW) + 1;
+
+    std::vector<MeetingTask> tasks;
+    std::vector<PromotionTask> promotionTasks;
+    int promotionByLevel[LEVEL_COUNT];
+    std::vector<std::vector<int>> tasksBySkill; // indexed by SkillId
+    static const std::vector<int> noTasks;
+
+    void indexTask(int taskIndex) {
+        SkillId skill = tasks[taskIndex].requiredSkill;
+        if (skill >= static_cast<SkillId>(tasksBySkill.size())) {
+            tasksBySkill.resize(skill + 1);
+        }
+        tasksBySkill[skill].push_back(taskIndex);
+    }
+
+    // The built-in catalog as compile-time data
+    static constexpr MeetingTaskSpec DEFAULT_TASKS[] = {
+        {"Lead Discussion", "Guide the team through a complex topic", "Leadership", 10, 25, 2},
+        {"Present Findings", "Share research results with the group", "Presentation", 8, 20, 2},
+        {"Resolve Conflict", "Mediate between disagreeing team members", "Communication", 12, 30, 3},
+        {"Brainstorm Solutions", "Generate creative ideas for challenges", "Problem_Solving", 6, 15, 1},
+        {"Coordinate Tasks", "Organize team efforts and delegate work", "Teamwork", 9, 22, 2},
+        {"Facilitate Workshop", "Run an interactive team building session", "Leadership", 15, 40, 3},
+        {"Document Decisions", "Create clear meeting minutes and action items", "Communication", 5, 12, 1},
+        {"Mentor Junior Member", "Help a new team member learn the ropes", "Teamwork", 7, 18, 2},
+    };
+
+    static constexpr PromotionTaskSpec DEFAULT_PROMOTION_TASKS[] = {
+        // Intern -> Engineer 1
+        {"Complete First Project", "Successfully deliver your first major project contribution",
+         JobLevel::INTERN, 15, 2, {{{"Communication", 3}, {"Teamwork", 3}}}},
         // Engineer 1 -> Engineer 2
-        promotionTasks.emplace_back("Lead Technical Initiative", 
-            "Take ownership of a technical solution and guide its implementation",
-            JobLevel::ENGINEER_1, 
-            std::map<std::string, int>{{"Problem_Solving", 5}, {"Leadership", 4}}, 18);
-        
+        {"Lead Technical Initiative", "Take ownership of a technical solution and guide its implementation",
+         JobLevel::ENGINEER_1, 18, 2, {{{"Leadership", 4}, {"Problem_Solving", 5}}}},
         // Engineer 2 -> Senior Engineer
-        promotionTasks.emplace_back("Mentor Junior Engineers", 
-            "Successfully guide and develop junior team members",
-            JobLevel::ENGINEER_2, 
-            std::map<std::string, int>{{"Leadership", 6}, {"Communication", 6}, {"Teamwork", 5}}, 22);
-        
+        {"Mentor Junior Engineers", "Successfully guide and develop junior team members",
+         JobLevel::ENGINEER_2, 22, 3, {{{"Communication", 6}, {"Leadership", 6}, {"Teamwork", 5}}}},
         // Senior Engineer -> Principal Engineer
-        promotionTasks.emplace_back("Drive Cross-Team Architecture", 
-            "Design and implement solutions spanning multiple teams",
-            JobLevel::SENIOR_ENGINEER, 
-            std::map<std::string, int>{{"Leadership", 8}, {"Problem_Solving", 8}, {"Presentation", 6}}, 28);
-        
+        {"Drive Cross-Team Architecture", "Design and implement solutions spanning multiple teams",
+         JobLevel::SENIOR_ENGINEER, 28, 3, {{{"Leadership", 8}, {"Presentation", 6}, {"Problem_Solving", 8}}}},
         // Principal Engineer -> Distinguished Engineer
-        promotionTasks.emplace_back("Establish Technical Strategy", 
-            "Define technical direction and standards for the organization",
-            JobLevel::PRINCIPAL_ENGINEER, 
-            std::map<std::string, int>{{"Leadership", 10}, {"Problem_Solving", 10}, {"Presentation", 8}}, 35);
+        {"Establish Technical Strategy", "Define technical direction and standards for the organization",
+         JobLevel::PRINCIPAL_ENGINEER, 35, 3, {{{"Leadership", 10}, {"Presentation", 8}, {"Problem_Solving", 10}}}},
+        // Distinguished Engineer -> Fellow
+        {"Shape Industry Standards", "Influence technical standards and practices across the industry",
+         JobLevel::DISTINGUISHED_ENGINEER, 45, 4,
+         {{{"Communication", 10}, {"Leadership", 12}, {"Presentation", 10}, {"Problem_Solving", 12}}}},
+    };
+
+    static std::vector<std::string> splitFields(const std::string& line) {
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, '|')) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+public:
+    TaskCatalog() {
+        std::fill(std::begin(promotionByLevel), std::end(promotionByLevel), -1);
+    }
+
+    // The built-in catalog the game has always shipped with.
+    static TaskCatalog defaults() {
+        TaskCatalog catalog;
+        for (const auto& spec : DEFAULT_TASKS) catalog.addTask(MeetingTask(spec));
+        for (const auto& spec : DEFAULT_PROMOTION_TASKS) catalog.addPromotionTask(PromotionTask(spec));
+        return catalog;
+    }
+
+    // The built-in catalog, built on first use and then shared read-only
+    // by every game that has not loaded its own, so constructing a game
+    // allocates nothing for its tasks.
+    static const std::shared_ptr<const TaskCatalog>& builtIn() {
+        static const std::shared_ptr<const TaskCatalog> catalog =
+            std::make_shared<const TaskCatalog>(defaults());
+        return catalog;
+    }
+
+    void addTask(const MeetingTask& task) {
+        tasks.push_back(task);
+        indexTask(static_cast<int>(tasks.size()) - 1);
+    }
+
+    // Returns false if the level already has a promotion task.
+    bool addPromotionTask(const PromotionTask& task) {
+        int level = static_cast<int>(task.requiredLevel);
+        if (level < 0 || level >= LEVEL_COUNT || promotionByLevel[level] >= 0) {
+            return false;
+        }
+        promotionTasks.push_back(task);
+        promotionByLevel[level] = static_cast<int>(promotionTasks.size()) - 1;
+        return true;
+    }
+
+    const std::vector<MeetingTask>& getTasks() const { return tasks; }
+    const std::vector<PromotionTask>& getPromotionTasks() const { return promotionTasks; }
+
+    // The task that promotes out of a level, or nullptr (e.g. for Fellows).
+    const PromotionTask* promotionTaskFor(JobLevel level) const {
+        int index = promotionByLevel[static_cast<int>(level)];
+        return index >= 0 ? &promotionTasks[index] : nullptr;
+    }
+
+    // Indices of the meeting tasks that train a skill.
+    const std::vector<int>& tasksForSkill(SkillId skill) const {
+        return (skill >= 0 && skill < static_cast<SkillId>(tasksBySkill.size())) ? tasksBySkill[skill]
+                                                                                 : noTasks;
+    }
+
+    // Parses a catalog file. On failure sets error, including the line.
+    static bool load(std::istream& in, TaskCatalog& catalog, std::string& error) {
+        TaskCatalog loaded;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(in, line)) {
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+
+            std::vector<std::string> fields = splitFields(line);
+            try {
+                if (fields[0] == "task" && fields.size() == 7) {
+                    loaded.addTask(MeetingTask(fields[1], fields[2], fields[3], std::stoi(fields[4]),
+                                               std::stoi(fields[5]), std::stoi(fields[6])));
+                    continue;
+                }
+                if (fields[0] == "promotion" && fields.size() == 6) {
+                    int level = std::stoi(fields[3]);
+                    std::map<std::string, int> requirements;
+                    std::stringstream reqStream(fields[5]);
+                    std::string req;
+                    while (std::getline(reqStream, req, ',')) {
+                        size_t colonPos = req.find(':');
+                        if (colonPos == std::string::npos) throw std::invalid_argument(req);
+                        requirements[req.substr(0, colonPos)] = std::stoi(req.substr(colonPos + 1));
+                    }
+                    if (level < 0 || level >= static_cast<int>(JobLevel::FELLOW) ||
+                        !loaded.addPromotionTask(PromotionTask(fields[1], fields[2], static_cast<JobLevel>(level),
+                                                               requirements, std::stoi(fields[4])))) {
+                        error = "line " + std::to_string(lineNumber) + ": invalid or duplicate promotion level";
+                        return false;
+                    }
+                    continue;
+                }
+            } catch (const std::exception&) {
+                // reported as malformed below
+            }
+            error = "line " + std::to_string(lineNumber) + ": malformed catalog entry";
+            return false;
+        }
+        if (loaded.tasks.empty()) {
+            error = "catalog defines no meeting tasks";
+            return false;
+        }
+        catalog = std::move(loaded);
+        return true;
+    }
+};
+
+const std::vector<int> TaskCatalog::noTasks;
+
+// SDEWG_SAVE_v2 layout, all integers in the writer's byte order:
+//   SaveHeaderV2
+//   StringRef[skillCount]                 skill column names
+//   CharacterRecord[characterCount]
+//   int32[characterCount * skillCount]    skill matrix, 0 = not held
+//   char[stringsSize]                     string table (names, skills)
+// Sections start on 8-byte boundaries. Loading copies fixed-size fields
+// straight out of the mapping; nothing is tokenized or parsed.
+class BinarySave {
+private:
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct CharacterRecord {
+        StringRef name;
+        int32_t experience;
+        int32_t level;
+        int32_t jobLevel;
+        int32_t eligibleForPromotion;
+        int32_t activitiesLeft;
+        int32_t daysSinceActivity;
+    };
+
+    struct SaveHeaderV2 {
+        char magic[16];
+        uint32_t byteOrder;
+        int32_t currentDay;
+        uint32_t characterCount;
+        uint32_t skillCount;
+        uint64_t skillNamesOffset;
+        uint64_t recordsOffset;
+        uint64_t skillValuesOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    static uint64_t align8(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+    // Whether count elements of elementSize bytes at offset lie within a
+    // file of size bytes, without overflowing on a corrupt header.
+    static bool fits(uint64_t offset, uint64_t count, uint64_t elementSize, size_t size) {
+        return offset <= size && count <= (size - offset) / elementSize;
+    }
+
+    static StringRef addString(std::string& table, const std::string& str) {
+        StringRef ref{static_cast<uint32_t>(table.size()), static_cast<uint32_t>(str.size())};
+        table += str;
+        return ref;
+    }
+
+public:
+    static constexpr const char* MAGIC = "SDEWG_SAVE_v2";
+
+    static bool isBinarySave(const char* data, size_t size) {
+        return size >= sizeof(SaveHeaderV2) && std::strncmp(data, MAGIC, 16) == 0;
+    }
+
+    static bool write(const std::string& filename, int currentDay,
+                      const std::vector<Character>& characters) {
+        const uint32_t skillCount = static_cast<uint32_t>(SkillRegistry::instance().size());
+        std::string strings;
+
+        std::vector<StringRef> skillNames(skillCount);
+        for (uint32_t id = 0; id < skillCount; ++id) {
+            skillNames[id] = addString(strings, skillName(id));
+        }
+
+        std::vector<CharacterRecord> records(characters.size());
+        std::vector<int32_t> skillValues(characters.size() * skillCount, 0);
+        for (size_t i = 0; i < characters.size(); ++i) {
+            const Character& character = characters[i];
+            records[i] = CharacterRecord{
+                addString(strings, character.getName()),
+                character.getExperience(),
+                character.getLevel(),
+                static_cast<int32_t>(character.getJobLevel()),
+                character.isEligibleForPromotion() ? 1 : 0,
+                character.getActivitiesLeft(),
+                character.getDaysSinceActivity()};
+            const std::vector<int>& skills = character.getSkills();
+            std::copy(skills.begin(), skills.end(), skillValues.begin() + i * skillCount);
+        }
+
+        SaveHeaderV2 header{};
+        std::strncpy(header.magic, MAGIC, sizeof(header.magic));
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.currentDay = currentDay;
+        header.characterCount = static_cast<uint32_t>(characters.size());
+        header.skillCount = skillCount;
+        header.skillNamesOffset = align8(sizeof(header));
+        header.recordsOffset = align8(header.skillNamesOffset + skillNames.size() * sizeof(StringRef));
+        header.skillValuesOffset = align8(header.recordsOffset + records.size() * sizeof(CharacterRecord));
+        header.stringsOffset = align8(header.skillValuesOffset + skillValues.size() * sizeof(int32_t));
+        header.stringsSize = strings.size();
+
+        std::string buffer(header.stringsOffset + strings.size(), '\0');
+        std::memcpy(&buffer[0], &header, sizeof(header));
+        std::memcpy(&buffer[header.skillNamesOffset], skillNames.data(), skillNames.size() * sizeof(StringRef));
+        if (!records.empty()) { // an empty vector's data() may be null
+            std::memcpy(&buffer[header.recordsOffset], records.data(), records.size() * sizeof(CharacterRecord));
+            std::memcpy(&buffer[header.skillValuesOffset], skillValues.data(), skillValues.size() * sizeof(int32_t));
+        }
+        std::memcpy(&buffer[header.stringsOffset], strings.data(), strings.size());
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+        file.write(buffer.data(), buffer.size());
+        return static_cast<bool>(file);
+    }
+
+    // Rebuilds the roster from a mapped v2 save. Returns false and sets
+    // error if the file is truncated or internally inconsistent.
+    static bool read(const char* data, size_t size, int& currentDay,
+                     std::vector<Character>& characters, std::string& error) {
+        SaveHeaderV2 header;
+        std::memcpy(&header, data, sizeof(header));
+        if (header.byteOrder != BYTE_ORDER_MARK) {
+            error = "save file was written with a different byte order";
+            return false;
+        }
+        const uint64_t skillCount = header.skillCount;
+        const uint64_t characterCount = header.characterCount;
+        const uint64_t skillRowSize = skillCount * sizeof(int32_t);
+        if (!fits(header.skillNamesOffset, skillCount, sizeof(StringRef), size) ||
+            !fits(header.recordsOffset, characterCount, sizeof(CharacterRecord), size) ||
+            !fits(header.skillValuesOffset, skillCount, sizeof(int32_t), size) ||
+            (skillCount > 0 && !fits(header.skillValuesOffset, characterCount, skillRowSize, size)) ||
+            !fits(header.stringsOffset, header.stringsSize, 1, size)) {
+            error = "save file is truncated";
+            return false;
+        }
+        const char* strings = data + header.stringsOffset;
+        auto inTable = [&](const StringRef& ref) {
+            return uint64_t(ref.offset) + ref.length <= header.stringsSize;
+        };
+
+        // Map the file's skill columns onto this process's skill IDs.
+        std::vector<SkillId> columnIds(skillCount);
+        SkillId maxId = CORE_SKILL_COUNT - 1;
+        for (uint64_t k = 0; k < skillCount; ++k) {
+            StringRef ref;
+            std::memcpy(&ref, data + header.skillNamesOffset + k * sizeof(StringRef), sizeof(ref));
+            if (!inTable(ref)) {
+                error = "skill name outside string table";
+                return false;
+            }
+            columnIds[k] = SkillRegistry::instance().intern(std::string(strings + ref.offset, ref.length));
+            maxId = std::max(maxId, columnIds[k]);
+        }
+
+        std::vector<Character> loaded;
+        loaded.reserve(characterCount);
+        const char* skillBase = data + header.skillValuesOffset;
+        for (uint64_t i = 0; i < characterCount; ++i) {
+            CharacterRecord record;
+            std::memcpy(&record, data + header.recordsOffset + i * sizeof(CharacterRecord), sizeof(record));
+            if (!inTable(record.name) || record.jobLevel < 0 ||
+                record.jobLevel > static_cast<int32_t>(JobLevel::FELLOW)) {
+                error = "corrupt character record " + std::to_string(i + 1);
+                return false;
+            }
+            std::vector<int> skills(maxId + 1, 0);
+            for (uint64_t k = 0; k < skillCount; ++k) {
+                int32_t value;
+                std::memcpy(&value, skillBase + (i * skillCount + k) * sizeof(int32_t), sizeof(value));
+                skills[columnIds[k]] = value;
+            }
+            loaded.emplace_back(std::string(strings + record.name.offset, record.name.length));
+            loaded.back().restoreState(record.experience, record.level,
+                                       static_cast<JobLevel>(record.jobLevel),
+                                       record.eligibleForPromotion != 0, record.activitiesLeft,
+                                       record.daysSinceActivity, std::move(skills));
+        }
+
+        currentDay = header.currentDay;
+        characters = std::move(loaded);
+        return true;
+    }
+};
+
+// Append-only log of roster changes made since the last full snapshot,
+// stored next to it as "<snapshot>.journal". Each record is framed as
+//   [u32 payload length][u8 type][payload][u32 checksum of type+payload]
+// so that replay stops cleanly at a torn final record. The header names
+// the snapshot it extends (day, roster size, file size); a journal that
+// does not match its snapshot is ignored.
+class SaveJournal {
+public:
+    enum RecordType : uint8_t {
+        DAY_ADVANCE = 1,   // value = days
+        CHARACTER_ADDED,   // text = name
+        CHARACTER_REMOVED, // index, later characters shift down
+        ACTIVITY_USED,     // index
+        EXPERIENCE_GAINED, // index, value = XP
+        SKILL_IMPROVED,    // index, value = points, text = skill name
+        PROMOTED,          // index
+        CHARACTER_SWAP_REMOVED // index, the last character moves into it
+    };
+
+    struct Record {
+        RecordType type;
+        int32_t index;
+        int32_t value;
+        std::string text;
+    };
+
+    struct SnapshotInfo {
+        int32_t currentDay;
+        uint32_t characterCount;
+        uint64_t snapshotSize;
+    };
+
+private:
+    static constexpr const char* MAGIC = "SDEWG_JOURNAL_v1";
+    static const size_t HEADER_SIZE = 16 + sizeof(SnapshotInfo);
+    static constexpr size_t MIN_COMPACTION_BYTES = 64 * 1024;
+
+    std::string snapshotPath;  // empty when not journaling
+    std::string pending;       // encoded records not yet on disk
+    size_t pendingDayRecord = std::string::npos;
+    uint64_t journalBytes = 0;
+    uint64_t snapshotBytes = 0;
+    bool snapshotRequired = false;
+
+    template <typename T>
+    static void put(std::string& buffer, T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    static T get(const char* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static std::string header(const SnapshotInfo& info) {
+        std::string buffer(MAGIC, 16);
+        put(buffer, info);
+        return buffer;
+    }
+
+public:
+    static uint32_t checksum(const char* data, size_t size) {
+        uint32_t hash = 2166136261u; // FNV-1a
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    static std::string pathFor(const std::string& snapshot) { return snapshot + ".journal"; }
+
+    bool isActive() const { return !snapshotPath.empty(); }
+    const std::string& getSnapshotPath() const { return snapshotPath; }
+
+    // True once the journal outgrows half the snapshot, or when a change
+    // that the journal cannot express has been made.
+    bool needsCompaction() const {
+        return snapshotRequired ||
+               journalBytes + pending.size() > std::max<uint64_t>(MIN_COMPACTION_BYTES, snapshotBytes / 2);
+    }
+
+    void requireSnapshot() { snapshotRequired = true; }
+
+    void unbind() {
+        snapshotPath.clear();
+        pending.clear();
+        pendingDayRecord = std::string::npos;
+    }
+
+    void record(RecordType type, int32_t index, int32_t value = 0, const std::string& text = "") {
+        if (!isActive()) return;
+        if (type == DAY_ADVANCE && pendingDayRecord != std::string::npos) {
+            // Consecutive day advances collapse into one record
+            const size_t valueOffset = pendingDayRecord + 4 + 1 + 4;
+            int32_t days = get<int32_t>(&pending[valueOffset]) + value;
+            std::memcpy(&pending[valueOffset], &days, sizeof(days));
+            uint32_t sum = checksum(&pending[pendingDayRecord + 4], 1 + 8);
+            std::memcpy(&pending[pendingDayRecord + 4 + 1 + 8], &sum, sizeof(sum));
+            return;
+        }
+        pendingDayRecord = (type == DAY_ADVANCE) ? pending.size() : std::string::npos;
+
+        const size_t start = pending.size();
+        put<uint32_t>(pending, 0);
+        put<uint8_t>(pending, type);
+        put<int32_t>(pending, index);
+        put<int32_t>(pending, value);
+        pending += text;
+        const uint32_t payloadSize = static_cast<uint32_t>(pending.size() - start - 5);
+        std::memcpy(&pending[start], &payloadSize, sizeof(payloadSize));
+        put<uint32_t>(pending, checksum(&pending[start + 4], 1 + payloadSize));
+    }
+
+    // Starts a new, empty journal for a freshly written snapshot.
+    bool startFresh(const std::string& snapshot, const SnapshotInfo& info) {
+        const std::string path = pathFor(snapshot);
+        const std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) return false;
+            const std::string bytes = header(info);
+            file.write(bytes.data(), bytes.size());
+            if (!file) return false;
+        }
+        if (std::rename(temp.c_str(), path.c_str()) != 0) return false;
+        snapshotPath = snapshot;
+        pending.clear();
+        pendingDayRecord = std::string::npos;
+        journalBytes = HEADER_SIZE;
+        snapshotBytes = info.snapshotSize;
+        snapshotRequired = false;
+        return true;
+    }
+
+    // Appends the pending records; cost is proportional to the changes.
+    bool flush() {
+        if (pending.empty()) return true;
+        std::ofstream file(pathFor(snapshotPath), std::ios::binary | std::ios::app);
+        if (!file.is_open()) return false;
+        file.write(pending.data(), pending.size());
+        if (!file) return false;
+        journalBytes += pending.size();
+        pending.clear();
+        pendingDayRecord = std::string::npos;
+        return true;
+    }
+
+    // Replays the journal of a snapshot through apply(). A torn or corrupt
+    // tail is cut off so later appends start from the last good record.
+    // Binds the journal to the snapshot on success.
+    template <typename Apply>
+    bool replay(const std::string& snapshot, const SnapshotInfo& info, Apply apply) {
+        const std::string path = pathFor(snapshot);
+        uint64_t goodBytes = 0;
+        {
+            MappedFile mapped(path);
+            if (!mapped.isOpen()) return false;
+            if (mapped.size() < HEADER_SIZE || std::memcmp(mapped.data(), MAGIC, 16) != 0) return false;
+            const SnapshotInfo base = get<SnapshotInfo>(mapped.data() + 16);
+            if (base.currentDay != info.currentDay || base.characterCount != info.characterCount ||
+                base.snapshotSize != info.snapshotSize) {
+                return false; // stale journal from before the last compaction
+            }
+
+            const char* data = mapped.data();
+            size_t offset = HEADER_SIZE;
+            while (offset + 4 + 1 + 8 + 4 <= mapped.size()) {
+                const uint32_t payloadSize = get<uint32_t>(data + offset);
+                if (payloadSize < 8 || offset + 4 + 1 + payloadSize + 4 > mapped.size()) break;
+                const char* body = data + offset + 4;
+                if (get<uint32_t>(body + 1 + payloadSize) != checksum(body, 1 + payloadSize)) break;
+
+                Record record{static_cast<RecordType>(body[0]), get<int32_t>(body + 1),
+                              get<int32_t>(body + 5), std::string(body + 9, payloadSize - 8)};
+                apply(record);
+                offset += 4 + 1 + payloadSize + 4;
+            }
+            goodBytes = offset;
+            if (goodBytes < mapped.size()) {
+                std::cerr << "Warning: discarded " << (mapped.size() - goodBytes)
+                          << " bytes of torn journal '" << path << "'\n";
+            }
+        }
+
+        std::error_code ec;
+        if (std::filesystem::file_size(path, ec) > goodBytes) {
+            std::filesystem::resize_file(path, goodBytes, ec);
+        }
+
+        snapshotPath = snapshot;
+        pending.clear();
+        pendingDayRecord = std::string::npos;
+        journalBytes = goodBytes;
+        snapshotBytes = info.snapshotSize;
+        snapshotRequired = false;
+        return true;
+    }
+};
+
+// A game's history: the roster as each day ends, appended to one file as
+// the days go by, so that any day can be rebuilt later. Most frames hold
+// only what changed since the day before; every keyframeInterval-th holds
+// the whole roster, so rebuilding a day decodes one keyframe and fewer than
+// keyframeInterval deltas. SDEWG_ARCHIVE_v1 layout:
+//   magic[16]
+//   frames, each [u32 payload length][u8 kind][payload][u32 checksum of kind+payload]
+//   index frame, then [u64 offset of the index frame]["SDEWGIDX"]
+// Payloads are varints, signed values zigzagged. A frame holds its day,
+// the skill names first used since the last frame (all of them in a
+// keyframe) and the roster size, then either every character (KEYFRAME)
+// or the positions that changed, each as the gap from the last one and a
+// mask of changed fields followed by their differences (DELTA).
+// Characters are stored as the game holds them, not brought up to the day,
+// so a character left alone costs nothing per day. The index is written
+// by close(); without it, e.g. after a crash, readers walk the frames.
+// Writing a day again, as after BasicMeetingGame::discard(), replaces it
+// and every later day.
+class SaveArchive {
+public:
+    static const int DEFAULT_KEYFRAME_INTERVAL = 32;
+
+    // One stored character; skills is indexed by the archive's skill
+    // columns (see Reader::getColumns()).
+    struct Row {
+        enum Field { EXPERIENCE, LEVEL, JOB_LEVEL, ELIGIBLE, ACTIVITIES_LEFT, DAYS_INACTIVE, SYNCED_DAY,
+                     FIELD_COUNT };
+        std::string name;
+        std::array<int32_t, FIELD_COUNT> fields{};
+        std::vector<int32_t> skills;
+    };
+
+private:
+    enum FrameKind : uint8_t { KEYFRAME = 1, DELTA, INDEX };
+    static constexpr const char* MAGIC = "SDEWG_ARCHIVE_v1";
+    static constexpr const char* INDEX_MAGIC = "SDEWGIDX";
+    static const size_t HEADER_SIZE = 16;
+    static const size_t TRAILER_SIZE = 8 + 8;
+    // DELTA masks: FULL for a whole row, else bit f + 1 per changed field
+    // and SKILLS for a list of changed skill columns
+    static const uint64_t FULL = 1;
+    static const uint64_t SKILLS = uint64_t(1) << (Row::FIELD_COUNT + 1);
+
+    struct IndexEntry {
+        int32_t day;
+        uint64_t offset;
+        bool keyframe;
+    };
+
+    // Reads a payload; ok turns false on running off its end.
+    struct Cursor {
+        const char* at;
+        const char* end;
+        bool ok;
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64 && at < end; shift += 7) {
+                const uint8_t byte = static_cast<uint8_t>(*at++);
+                value |= uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            ok = false;
+            return 0;
+        }
+
+        int64_t value() {
+            const uint64_t zigzag = varint();
+            return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        }
+
+        std::string_view text() {
+            const uint64_t length = varint();
+            if (!ok || length > static_cast<uint64_t>(end - at)) {
+                ok = false;
+                return {};
+            }
+            std::string_view result(at, length);
+            at += length;
+            return result;
+        }
+    };
+
+    static void putVarint(std::string& out, uint64_t value) {
+        for (; value >= 0x80; value >>= 7) {
+            out += static_cast<char>(value | 0x80);
+        }
+        out += static_cast<char>(value);
+    }
+
+    static void putValue(std::string& out, int64_t value) {
+        putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    static void putText(std::string& out, std::string_view text) {
+        putVarint(out, text.size());
+        out += text;
+    }
+
+    static std::array<int32_t, Row::FIELD_COUNT> fieldsOf(const Character& character) {
+        return {character.getExperience(), character.getLevel(), static_cast<int32_t>(character.getJobLevel()),
+                character.isEligibleForPromotion() ? 1 : 0, character.getActivitiesLeft(),
+                character.getDaysSinceActivity(), character.getSyncedDay()};
+    }
+
+    // Compares skill values the way putDifference() diffs them: a row and a
+    // character may hold lists of different lengths, so the shorter one
+    // counts as padded with zeros.
+    static bool sameSkills(const Row& row, const std::vector<int>& skills) {
+        for (size_t k = 0; k < std::max(row.skills.size(), skills.size()); ++k) {
+            if ((k < row.skills.size() ? row.skills[k] : 0) != (k < skills.size() ? skills[k] : 0)) return false;
+        }
+        return true;
+    }
+
+    static bool matches(const Row& row, const Character& character) {
+        return row.fields == fieldsOf(character) && sameSkills(row, character.getSkills()) &&
+               row.name == character.getName();
+    }
+
+    static void capture(const Character& character, Row& row) {
+        row.name = character.getName();
+        row.fields = fieldsOf(character);
+        row.skills.assign(character.getSkills().begin(), character.getSkills().end());
+    }
+
+    static void putRow(std::string& out, const Row& row) {
+        putText(out, row.name);
+        for (int32_t field : row.fields) putValue(out, field);
+        putVarint(out, row.skills.size());
+        for (int32_t value : row.skills) putValue(out, value);
+    }
+
+    // Writes what changed from row to character and brings row up to date.
+    static void putDifference(std::string& out, Row& row, const Character& character) {
+        const auto fields = fieldsOf(character);
+        const std::vector<int>& skills = character.getSkills();
+        uint64_t mask = 0;
+        for (int f = 0; f < Row::FIELD_COUNT; ++f) {
+            if (fields[f] != row.fields[f]) mask |= uint64_t(1) << (f + 1);
+        }
+        if (!sameSkills(row, skills)) mask |= SKILLS;
+        putVarint(out, mask);
+        for (int f = 0; f < Row::FIELD_COUNT; ++f) {
+            if (fields[f] != row.fields[f]) putValue(out, int64_t(fields[f]) - row.fields[f]);
+        }
+        row.fields = fields;
+        if (mask & SKILLS) {
+            row.skills.resize(std::max(row.skills.size(), skills.size()), 0);
+            size_t changed = 0;
+            for (size_t k = 0; k < row.skills.size(); ++k) {
+                changed += (k < skills.size() ? skills[k] : 0) != row.skills[k];
+            }
+            putVarint(out, changed);
+            size_t previous = 0;
+            for (size_t k = 0; k < row.skills.size(); ++k) {
+                const int32_t value = k < skills.size() ? skills[k] : 0;
+                if (value == row.skills[k]) continue;
+                putVarint(out, k - previous);
+                putValue(out, int64_t(value) - row.skills[k]);
+                row.skills[k] = value;
+                previous = k;
+            }
+        }
+    }
+
+    std::ofstream file;
+    std::string frame; // the frame being written
+    std::string changes;
+    std::vector<Row> rows; // the roster as last written
+    std::vector<IndexEntry> index;
+    uint64_t fileSize = 0;
+    size_t columns = 0; // skill names written so far
+    int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+    int sinceKeyframe = 0;
+
+    void startFrame(FrameKind kind) {
+        frame.assign(4, '\0');
+        frame += static_cast<char>(kind);
+    }
+
+    bool writeFrame() {
+        const uint32_t payloadSize = static_cast<uint32_t>(frame.size() - 5);
+        std::memcpy(&frame[0], &payloadSize, sizeof(payloadSize));
+        const uint32_t sum = SaveJournal::checksum(&frame[4], 1 + payloadSize);
+        frame.append(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        file.write(frame.data(), frame.size());
+        file.flush();
+        fileSize += frame.size();
+        return static_cast<bool>(file);
+    }
+
+public:
+    // Random access to the days of an archive file.
+    class Reader {
+    private:
+        MappedFile mapped;
+        std::vector<IndexEntry> index;
+        std::vector<std::string> columns;
+        std::vector<Row> rows;
+        int decoded = -1; // the index entry rows reflects
+        bool opened = false;
+        std::string error;
+
+        bool frameAt(uint64_t offset, uint8_t& kind, Cursor& payload) const {
+            if (offset < HEADER_SIZE || offset + 4 + 1 + 4 > mapped.size()) return false;
+            const char* data = mapped.data() + offset;
+            uint32_t payloadSize, sum;
+            std::memcpy(&payloadSize, data, sizeof(payloadSize));
+            if (payloadSize > mapped.size() - offset - 4 - 1 - 4) return false;
+            std::memcpy(&sum, data + 4 + 1 + payloadSize, sizeof(sum));
+            if (sum != SaveJournal::checksum(data + 4, 1 + payloadSize)) return false;
+            kind = static_cast<uint8_t>(data[4]);
+            payload = Cursor{data + 5, data + 5 + payloadSize, true};
+            return true;
+        }
+
+        bool readIndex() {
+            const size_t size = mapped.size();
+            if (size < HEADER_SIZE + TRAILER_SIZE || std::memcmp(mapped.data() + size - 8, INDEX_MAGIC, 8) != 0) {
+                return false;
+            }
+            uint64_t offset;
+            std::memcpy(&offset, mapped.data() + size - TRAILER_SIZE, sizeof(offset));
+            uint8_t kind;
+            Cursor in;
+            if (!frameAt(offset, kind, in) || kind != INDEX) return false;
+            const uint64_t count = in.varint();
+            if (count > static_cast<uint64_t>(in.end - in.at)) return false;
+            index.resize(count);
+            int64_t day = 0;
+            uint64_t at = 0;
+            for (auto& entry : index) {
+                day += in.value();
+                at += in.varint();
+                entry = IndexEntry{static_cast<int32_t>(day), at, in.varint() != 0};
+            }
+            return in.ok;
+        }
+
+        // Without an index, walks the frames up to the first torn one.
+        void scanFrames() {
+            index.clear();
+            uint64_t offset = HEADER_SIZE;
+            uint8_t kind;
+            Cursor in;
+            while (frameAt(offset, kind, in)) {
+                if (kind == KEYFRAME || kind == DELTA) {
+                    const int32_t day = static_cast<int32_t>(in.value());
+                    while (!index.empty() && index.back().day >= day) index.pop_back();
+                    index.push_back(IndexEntry{day, offset, kind == KEYFRAME});
+                }
+                offset += 4 + 1 + (in.end - (mapped.data() + offset + 5)) + 4;
+            }
+        }
+
+        bool getRow(Cursor& in, Row& row) const {
+            row.name = in.text();
+            for (int32_t& field : row.fields) field = static_cast<int32_t>(in.value());
+            const uint64_t count = in.varint();
+            if (count > columns.size()) return false;
+            row.skills.resize(count);
+            for (int32_t& value : row.skills) value = static_cast<int32_t>(in.value());
+            return in.ok;
+        }
+
+        bool applyFrame(const IndexEntry& entry) {
+            uint8_t kind;
+            Cursor in;
+            if (!frameAt(entry.offset, kind, in) || kind != (entry.keyframe ? KEYFRAME : DELTA)) return false;
+            in.value(); // the day, already in the index
+            const uint64_t first = in.varint();
+            const uint64_t added = in.varint();
+            if (!in.ok || first > columns.size() || added > static_cast<uint64_t>(in.end - in.at)) return false;
+            columns.resize(first);
+            for (uint64_t k = 0; k < added; ++k) columns.emplace_back(in.text());
+
+            // Every row takes at least a byte, or is already there
+            const uint64_t count = in.varint();
+            if (!in.ok || count > (entry.keyframe ? 0 : rows.size()) + static_cast<uint64_t>(in.end - in.at)) {
+                return false;
+            }
+            if (entry.keyframe) {
+                rows.resize(count);
+                for (auto& row : rows) {
+                    if (!getRow(in, row)) return false;
+                }
+                return true;
+            }
+
+            const size_t kept = std::min<size_t>(rows.size(), count);
+            rows.resize(count);
+            const uint64_t changed = in.varint();
+            uint64_t position = 0;
+            for (uint64_t c = 0; c < changed && in.ok; ++c) {
+                position += in.varint() + (c > 0);
+                if (position >= count) return false;
+                Row& row = rows[position];
+                const uint64_t mask = in.varint();
+                if (mask & FULL) {
+                    if (!getRow(in, row)) return false;
+                    continue;
+                }
+                if (position >= kept) return false;
+                for (int f = 0; f < Row::FIELD_COUNT; ++f) {
+                    if (mask & (uint64_t(1) << (f + 1))) row.fields[f] += static_cast<int32_t>(in.value());
+                }
+                if (mask & SKILLS) {
+                    const uint64_t skills = in.varint();
+                    uint64_t column = 0;
+                    for (uint64_t k = 0; k < skills && in.ok; ++k) {
+                        column += in.varint();
+                        if (column >= columns.size()) return false;
+                        if (column >= row.skills.size()) row.skills.resize(column + 1, 0);
+                        row.skills[column] += static_cast<int32_t>(in.value());
+                    }
+                }
+            }
+            return in.ok;
+        }
+
+    public:
+        explicit Reader(const std::string& filename) : mapped(filename) {
+            if (!mapped.isOpen()) {
+                error = "could not open archive '" + filename + "'";
+            } else if (mapped.size() < HEADER_SIZE || std::memcmp(mapped.data(), MAGIC, 16) != 0) {
+                error = "'" + filename + "' is not an archive";
+            } else if (!readIndex()) {
+                scanFrames();
+            }
+            if (error.empty() && (index.empty() || !index.front().keyframe)) {
+                error = "archive '" + filename + "' holds no days";
+            }
+            opened = error.empty();
+        }
+
+        bool isOpen() const { return opened; }
+        const std::string& getError() const { return error; }
+        const std::vector<std::string>& getColumns() const { return columns; }
+        const std::vector<Row>& getRows() const { return rows; }
+
+        std::vector<int> days() const {
+            std::vector<int> result;
+            result.reserve(index.size());
+            for (const auto& entry : index) result.push_back(entry.day);
+            return result;
+        }
+
+        // Rebuilds getRows() as the last archived day at or before day
+        // ended, decoding forward from the rows already built when it can.
+        // Returns that day, or 0 (see getError()) if there is none.
+        int seek(int day) {
+            if (!isOpen()) return 0;
+            const auto found = std::upper_bound(index.begin(), index.end(), day,
+                                                [](int d, const IndexEntry& entry) { return d < entry.day; });
+            if (found == index.begin() || day > index.back().day) {
+                error = "day " + std::to_string(day) + " is not in the archive";
+                return 0;
+            }
+            const int target = static_cast<int>(found - index.begin()) - 1;
+            int from = target;
+            while (!index[from].keyframe) --from;
+            if (decoded >= from && decoded <= target) from = decoded + 1;
+            for (int i = from; i <= target; ++i) {
+                if (!applyFrame(index[i])) {
+                    error = "corrupt frame for day " + std::to_string(index[i].day);
+                    decoded = -1;
+                    return 0;
+                }
+                decoded = i;
+            }
+            return index[target].day;
+        }
+    };
+
+    SaveArchive() = default;
+    SaveArchive(const SaveArchive&) = delete;
+    SaveArchive& operator=(const SaveArchive&) = delete;
+    ~SaveArchive() { close(); }
+
+    bool isOpen() const { return file.is_open(); }
+
+    // Starts a new archive, replacing any file of that name.
+    bool open(const std::string& filename, int interval = DEFAULT_KEYFRAME_INTERVAL) {
+        close();
+        file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(MAGIC, HEADER_SIZE);
+        rows.clear();
+        index.clear();
+        fileSize = HEADER_SIZE;
+        columns = 0;
+        keyframeInterval = std::max(1, interval);
+        sinceKeyframe = 0;
+        return static_cast<bool>(file);
+    }
+
+    // Appends the roster as it stands at the end of day. Costs a pass over
+    // the roster and a few bytes per character that changed.
+    bool append(int day, const std::vector<Character>& characters) {
+        if (!isOpen()) return false;
+        bool rewound = false;
+        while (!index.empty() && index.back().day >= day) {
+            index.pop_back();
+            rewound = true;
+        }
+        const bool keyframe = index.empty() || rewound || sinceKeyframe + 1 >= keyframeInterval;
+        index.push_back(IndexEntry{day, fileSize, keyframe});
+
+        startFrame(keyframe ? KEYFRAME : DELTA);
+        putValue(frame, day);
+        const size_t first = keyframe ? 0 : columns;
+        columns = SkillRegistry::instance().size();
+        putVarint(frame, first);
+        putVarint(frame, columns - first);
+        for (size_t id = first; id < columns; ++id) {
+            putText(frame, skillName(static_cast<SkillId>(id)));
+        }
+        putVarint(frame, characters.size());
+
+        if (keyframe) {
+            rows.resize(characters.size());
+            for (size_t i = 0; i < characters.size(); ++i) {
+                capture(characters[i], rows[i]);
+                putRow(frame, rows[i]);
+            }
+            sinceKeyframe = 0;
+            return writeFrame();
+        }
+
+        changes.clear();
+        uint64_t changed = 0;
+        size_t previous = 0;
+        rows.resize(std::min(rows.size(), characters.size()));
+        for (size_t i = 0; i < characters.size(); ++i) {
+            const Character& character = characters[i];
+            if (i < rows.size() && matches(rows[i], character)) continue;
+            putVarint(changes, changed > 0 ? i - previous - 1 : i);
+            previous = i;
+            changed++;
+            if (i < rows.size() && rows[i].name == character.getName()) {
+                putDifference(changes, rows[i], character);
+            } else {
+                if (i == rows.size()) rows.emplace_back();
+                capture(character, rows[i]);
+                putVarint(changes, FULL);
+                putRow(changes, rows[i]);
+            }
+        }
+        putVarint(frame, changed);
+        frame += changes;
+        sinceKeyframe++;
+        return writeFrame();
+    }
+
+    // Writes the index and closes the file.
+    bool close() {
+        if (!isOpen()) return true;
+        const uint64_t indexOffset = fileSize;
+        startFrame(INDEX);
+        putVarint(frame, index.size());
+        int64_t day = 0;
+        uint64_t offset = 0;
+        for (const auto& entry : index) {
+            putValue(frame, entry.day - day);
+            putVarint(frame, entry.offset - offset);
+            frame += static_cast<char>(entry.keyframe);
+            day = entry.day;
+            offset = entry.offset;
+        }
+        bool ok = writeFrame();
+        file.write(reinterpret_cast<const char*>(&indexOffset), sizeof(indexOffset));
+        file.write(INDEX_MAGIC, 8);
+        ok = ok && static_cast<bool>(file);
+        file.close();
+        return ok;
+    }
+
+    // Rebuilds the roster as it stood on day (see Reader::seek()), brought
+    // up to that day.
+    static bool read(const std::string& filename, int day, std::vector<Character>& characters,
+                     std::string& error) {
+        Reader reader(filename);
+        if (!reader.seek(day)) {
+            error = reader.getError();
+            return false;
+        }
+        std::vector<SkillId> columnIds;
+        SkillId maxId = CORE_SKILL_COUNT - 1;
+        for (const auto& column : reader.getColumns()) {
+            columnIds.push_back(SkillRegistry::instance().intern(column));
+            maxId = std::max(maxId, columnIds.back());
+        }
+
+        std::vector<Character> loaded;
+        loaded.reserve(reader.getRows().size());
+        for (const Row& row : reader.getRows()) {
+            if (row.fields[Row::JOB_LEVEL] < 0 || row.fields[Row::JOB_LEVEL] > static_cast<int32_t>(JobLevel::FELLOW)) {
+                error = "corrupt character '" + row.name + "'";
+                return false;
+            }
+            std::vector<int> skills(maxId + 1, 0);
+            for (size_t k = 0; k < row.skills.size(); ++k) {
+                skills[columnIds[k]] = row.skills[k];
+            }
+            loaded.emplace_back(row.name);
+            Character& character = loaded.back();
+            character.setEventSink(nullSink());
+            character.restoreState(row.fields[Row::EXPERIENCE], row.fields[Row::LEVEL],
+                                   static_cast<JobLevel>(row.fields[Row::JOB_LEVEL]),
+                                   row.fields[Row::ELIGIBLE] != 0, row.fields[Row::ACTIVITIES_LEFT],
+                                   row.fields[Row::DAYS_INACTIVE], std::move(skills));
+            character.startOnDay(row.fields[Row::SYNCED_DAY]);
+            character.advanceTo(day);
+        }
+        characters = std::move(loaded);
+        return true;
+    }
+};
+
+// Identifies one dice roll: the game day, the rolling character's id, how
+// many activities it had used that day, and a caller-chosen stream (e.g. a
+// simulation trial number).
+struct RollKey {
+    uint32_t day;
+    uint32_t character;
+    uint32_t action;
+    uint32_t stream;
+};
+
+// Dice policies for BasicMeetingGame provide roll(const RollKey&) and
+// roll(const RollKey*, int32_t*, size_t), each returning values in
+// 1..SIDES. DiceRoller ignores the keys and deals rolls in the order they
+// are asked for; CounterDice derives every roll from its key alone.
+
+// Rolls d20s in bulk. LANES independent xoshiro128++ generators are
+// stepped in lockstep with their state stored lane by lane, so the loops in
+// refill() compile to SIMD instructions instead of one long dependency
+// chain. Single rolls are served from the same buffer, so the sequence of
+// rolls a seed produces does not depend on how they are batched.
+class DiceRoller {
+public:
+    static const int SIDES = 20;
+
+private:
+    static const int LANES = 8;
+    static const int ROUNDS = 64;
+    static const int BLOCK = LANES * ROUNDS; // rolls per refill
+    // 2^32 mod SIDES: products whose low half falls below this are the
+    // biased tail of the multiply-shift mapping and are redrawn
+    static const uint32_t REJECT_BELOW = static_cast<uint32_t>((uint64_t(1) << 32) % SIDES);
+
+    alignas(32) uint32_t s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+    alignas(32) uint32_t bits[BLOCK];
+    alignas(32) int32_t buffer[BLOCK];
+    int next = BLOCK;
+
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    static uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    void refill() {
+        // Step the lanes on local copies of the state; GCC only vectorizes
+        // the lane loop once it can see nothing else aliases the state.
+        uint32_t a[LANES], b[LANES], c[LANES], d[LANES];
+        for (int lane = 0; lane < LANES; ++lane) {
+            a[lane] = s0[lane];
+            b[lane] = s1[lane];
+            c[lane] = s2[lane];
+            d[lane] = s3[lane];
+        }
+        for (int round = 0; round < ROUNDS; ++round) {
+            uint32_t* out = bits + round * LANES;
+            for (int lane = 0; lane < LANES; ++lane) {
+                out[lane] = rotl(a[lane] + d[lane], 7) + a[lane];
+                const uint32_t t = b[lane] << 9;
+                c[lane] ^= a[lane];
+                d[lane] ^= b[lane];
+                b[lane] ^= c[lane];
+                a[lane] ^= d[lane];
+                c[lane] ^= t;
+                d[lane] = rotl(d[lane], 11);
+            }
+        }
+        for (int lane = 0; lane < LANES; ++lane) {
+            s0[lane] = a[lane];
+            s1[lane] = b[lane];
+            s2[lane] = c[lane];
+            s3[lane] = d[lane];
+        }
+
+        uint32_t rejected = 0;
+        for (int i = 0; i < BLOCK; ++i) {
+            buffer[i] = toRoll(bits[i]);
+            rejected |= buffer[i] == 0;
+        }
+        // Odds of 4e-9 per roll, so redraw these one at a time from lane 0
+        if (rejected) {
+            for (int i = 0; i < BLOCK; ++i) {
+                while (buffer[i] == 0) {
+                    const uint32_t next0 = rotl(s0[0] + s3[0], 7) + s0[0];
+                    const uint32_t t = s1[0] << 9;
+                    s2[0] ^= s0[0];
+                    s3[0] ^= s1[0];
+                    s1[0] ^= s2[0];
+                    s0[0] ^= s3[0];
+                    s2[0] ^= t;
+                    s3[0] = rotl(s3[0], 11);
+                    buffer[i] = toRoll(next0);
+                }
+            }
+        }
+        next = 0;
+    }
+
+public:
+    // Maps 32 random bits to 1..SIDES (the high half of bits * SIDES), or
+    // 0 for a rejected draw. Only 32-bit arithmetic, so that it vectorizes
+    // without 64-bit multiplies.
+    static int32_t toRoll(uint32_t bits) {
+        const uint32_t low = bits * SIDES;
+        const uint32_t high = ((bits >> 16) * SIDES + (((bits & 0xFFFF) * SIDES) >> 16)) >> 16;
+        return low < REJECT_BELOW ? 0 : static_cast<int32_t>(high) + 1;
+    }
+
+    explicit DiceRoller(uint64_t seed) {
+        for (int lane = 0; lane < LANES; ++lane) {
+            const uint64_t a = splitmix64(seed), b = splitmix64(seed);
+            s0[lane] = static_cast<uint32_t>(a);
+            s1[lane] = static_cast<uint32_t>(a >> 32);
+            s2[lane] = static_cast<uint32_t>(b);
+            s3[lane] = static_cast<uint32_t>(b >> 32);
+        }
+    }
+
+    int roll() {
+        if (next == BLOCK) refill();
+        return buffer[next++];
+    }
+
+    // Fills out[0..count) with rolls; the same rolls count calls to roll()
+    // would have returned.
+    void roll(int32_t* out, size_t count) {
+        while (count > 0) {
+            if (next == BLOCK) refill();
+            const size_t n = std::min(count, static_cast<size_t>(BLOCK - next));
+            std::memcpy(out, buffer + next, n * sizeof(int32_t));
+            next += static_cast<int>(n);
+            out += n;
+            count -= n;
+        }
+    }
+
+    int roll(const RollKey&) { return roll(); }
+    void roll(const RollKey*, int32_t* out, size_t count) { roll(out, count); }
+
+    // Rounds a batch size up to whole SIMD blocks, the size successMask()
+    // expects its arrays to be allocated with.
+    static size_t padded(size_t count) { return (count + LANES - 1) / LANES * LANES; }
+
+    // success[i] = rolls[i] + bonus[i] >= target over padded(count)
+    // entries. The arrays must not overlap, and the mask is int32_t like the
+    // inputs so every lane has the same width; together with the fixed-size
+    // inner loop that lets it vectorize at -O2.
+    static void successMask(const int32_t* __restrict rolls, const int32_t* __restrict bonus,
+                            int32_t target, int32_t* __restrict success, size_t count) {
+        for (size_t block = 0; block < count; block += LANES) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                success[block + lane] = rolls[block + lane] + bonus[block + lane] >= target;
+            }
+        }
+    }
+};
+
+// Counter-based dice: each roll is Philox4x32-10 applied to its RollKey
+// under the seed, so it depends on nothing but (seed, key). Games that
+// share a seed produce bit-identical results whichever thread runs them
+// and in whatever order they are evaluated.
+class CounterDice {
+private:
+    uint32_t key0, key1;
+
+    static uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t& high) {
+        const uint64_t product = uint64_t(a) * b;
+        high = static_cast<uint32_t>(product >> 32);
+        return static_cast<uint32_t>(product);
+    }
+
+public:
+    explicit CounterDice(uint64_t seed)
+        : key0(static_cast<uint32_t>(seed)), key1(static_cast<uint32_t>(seed >> 32)) {}
+
+    // The four 32-bit Philox outputs for a counter block.
+    void block(const RollKey& key, uint32_t out[4]) const {
+        uint32_t c0 = key.day, c1 = key.character, c2 = key.action, c3 = key.stream;
+        uint32_t k0 = key0, k1 = key1;
+        for (int round = 0; round < 10; ++round) {
+            uint32_t high0, high1;
+            const uint32_t low0 = mulhilo(0xD2511F53u, c0, high0);
+            const uint32_t low1 = mulhilo(0xCD9E8D57u, c2, high1);
+            c0 = high1 ^ c1 ^ k0;
+            c1 = low1;
+            c2 = high0 ^ c3 ^ k1;
+            c3 = low0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    int roll(const RollKey& key) const {
+        uint32_t bits[4];
+        block(key, bits);
+        // Use the first unbiased word; all four being rejected (odds of
+        // 3e-34) falls back to the last one's slightly biased value
+        for (uint32_t word : bits) {
+            if (int32_t value = DiceRoller::toRoll(word)) return value;
+        }
+        return static_cast<int>(uint64_t(bits[3]) * DiceRoller::SIDES >> 32) + 1;
+    }
+
+    void roll(const RollKey* keys, int32_t* out, size_t count) const {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = roll(keys[i]);
+        }
+    }
+};
+
+// Exact odds of the outcomes of meeting tasks and promotion attempts. Every
+// roll is a uniform d20, so an attempt succeeds on a fixed number of its
+// faces; the face and chance tables are built at compile time and the rest
+// is a few multiplications, cheap enough to rank every option a character
+// has without simulating any of them.
+class OutcomeOdds {
+public:
+    static constexpr int SIDES = DiceRoller::SIDES;
+
+private:
+    // FACES_FROM[t] = faces showing t or more, for targets 0..SIDES + 1
+    static constexpr std::array<int, SIDES + 2> FACES_FROM = [] {
+        std::array<int, SIDES + 2> faces{};
+        for (int target = 0; target <= SIDES + 1; ++target) {
+            faces[target] = SIDES + 1 - std::max(target, 1);
+        }
+        return faces;
+    }();
+
+    // CHANCE[f] = probability that a roll lands on one of f given faces
+    static constexpr std::array<double, SIDES + 1> CHANCE = [] {
+        std::array<double, SIDES + 1> chance{};
+        for (int faces = 0; faces <= SIDES; ++faces) {
+            chance[faces] = faces / static_cast<double>(SIDES);
+        }
+        return chance;
+    }();
+
+public:
+    struct TaskOutcome {
+        int successFaces;     // faces of the d20 that succeed, 0..SIDES
+        double success;       // successFaces / SIDES
+        double expectedXp;    // from the member's own roll; see teamXpBonus()
+        double expectedSkill; // points gained in the task's skill
+    };
+
+    struct PromotionOutcome {
+        bool meetsRequirements;
+        int successFaces;
+        double success;
+        double expectedXp;
+    };
+
+    // Bonus every member of a team of the given size adds to their roll
+    static constexpr int teamBonus(size_t teamSize) {
+        // 10% per additional member, max 50%
+        return std::min(4, static_cast<int>(teamSize - 1)) * 2;
+    }
+
+    // XP every member earns when at least one of the team succeeds
+    static constexpr int teamSuccessXp(size_t teamSize) {
+        return 5 * static_cast<int>(teamSize - 1);
+    }
+
+    // Faces of the d20 on which a roll reaches target.
+    static constexpr int successFaces(int target) {
+        return FACES_FROM[std::clamp(target, 0, SIDES + 1)];
+    }
+
+    static constexpr double chance(int faces) { return CHANCE[faces]; }
+
+    // Odds for one member of a team of teamSize at a task, given their
+    // level in its skill.
+    static constexpr TaskOutcome task(int difficulty, int expReward, int skillReward,
+                                      int skill, size_t teamSize) {
+        const int faces = successFaces(difficulty - skill - teamBonus(teamSize));
+        const double p = CHANCE[faces];
+        return {faces, p, p * expReward + (1 - p) * (expReward / 3), p * skillReward};
+    }
+
+    static TaskOutcome task(const MeetingTask& task, const Character& character, size_t teamSize = 1) {
+        return OutcomeOdds::task(task.difficulty, task.expReward, task.skillReward,
+                                 character.getSkill(task.requiredSkill), teamSize);
+    }
+
+    // Chance that at least one member of a team succeeds at a task, where
+    // skills[i] is member i's level in its skill.
+    static double anySuccess(const MeetingTask& task, const int* skills, size_t teamSize) {
+        const int bonus = teamBonus(teamSize);
+        double allFail = 1.0;
+        for (size_t i = 0; i < teamSize; ++i) {
+            allFail *= CHANCE[SIDES - successFaces(task.difficulty - skills[i] - bonus)];
+        }
+        return 1.0 - allFail;
+    }
+
+    // Expected team success XP for each member of the team.
+    static double teamXpBonus(const MeetingTask& task, const int* skills, size_t teamSize) {
+        return teamSize > 1 ? anySuccess(task, skills, teamSize) * teamSuccessXp(teamSize) : 0.0;
+    }
+
+    // Odds of an attempt at the promotion task, with the XP it is worth
+    // as attemptPromotionTask() awards it: 25 when requirements are unmet,
+    // 50 for a failed roll and the 100 promotion bonus on success.
+    static PromotionOutcome promotion(const PromotionTask& task, const Character& character) {
+        bool meets = true;
+        int totalBonus = 0;
+        for (const auto& req : task.skillRequirements) {
+            const int skill = character.getSkill(req.first);
+            meets = meets && skill >= req.second;
+            totalBonus += skill;
+        }
+        if (!meets) return {false, 0, 0.0, 25.0};
+        const int faces = successFaces(task.difficulty - totalBonus);
+        const double p = CHANCE[faces];
+        return {true, faces, p, p * 100 + (1 - p) * 50};
+    }
+};
+
+static_assert(OutcomeOdds::successFaces(1) == OutcomeOdds::SIDES, "a 1 or better always succeeds");
+static_assert(OutcomeOdds::successFaces(OutcomeOdds::SIDES + 1) == 0, "beyond the die never succeeds");
+static_assert(OutcomeOdds::task(15, 30, 2, 1, 3).successFaces == 11, "10 or better on the d20");
+
+// Stable reference to an element of a SlotMap. It goes stale when the
+// element is removed, even if its slot is later reused.
+struct SlotHandle {
+    uint32_t slot;
+    uint32_t generation;
+
+    bool operator==(const SlotHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Values stored densely, like a vector, and also reachable through
+// generational handles. Removal swaps the last value into the hole, so it
+// is O(1) and iteration stays dense, but it reorders the values; handles
+// follow their value wherever it moves.
+template <typename T>
+class SlotMap {
+public:
+    static constexpr SlotHandle NO_HANDLE{UINT32_MAX, 0};
+
+private:
+    static const uint32_t FREE = UINT32_MAX;
+
+    struct Slot {
+        uint32_t index;      // into values, FREE when unused
+        uint32_t generation; // bumped whenever the slot's value is removed
+    };
+
+    std::vector<T> values;
+    std::vector<uint32_t> slotOf; // by value index
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    SlotHandle attachLast() {
+        uint32_t slot;
+        if (freeSlots.empty()) {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{FREE, 0});
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        slots[slot].index = static_cast<uint32_t>(values.size() - 1);
+        slotOf.push_back(slot);
+        return SlotHandle{slot, slots[slot].generation};
+    }
+
+    void release(uint32_t slot) {
+        slots[slot].index = FREE;
+        slots[slot].generation++;
+        freeSlots.push_back(slot);
+    }
+
+public:
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    T& operator[](size_t index) { return values[index]; }
+    const T& operator[](size_t index) const { return values[index]; }
+    T& back() { return values.back(); }
+    T* data() { return values.data(); }
+    const T* data() const { return values.data(); }
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+    // The values in iteration order.
+    const std::vector<T>& dense() const { return values; }
+
+    SlotHandle push_back(const T& value) {
+        values.push_back(value);
+        return attachLast();
+    }
+
+    template <typename... Args>
+    SlotHandle emplace_back(Args&&... args) {
+        values.emplace_back(std::forward<Args>(args)...);
+        return attachLast();
+    }
+
+    SlotHandle handleAt(size_t index) const {
+        const uint32_t slot = slotOf[index];
+        return SlotHandle{slot, slots[slot].generation};
+    }
+
+    // Index of the handle's value, or -1 once it has been removed.
+    int indexOf(SlotHandle handle) const {
+        if (handle.slot >= slots.size() || slots[handle.slot].generation != handle.generation) {
+            return -1;
+        }
+        const uint32_t index = slots[handle.slot].index;
+        return index == FREE ? -1 : static_cast<int>(index);
+    }
+
+    bool contains(SlotHandle handle) const { return indexOf(handle) >= 0; }
+
+    // Removes the value at index in O(1) by moving the last value into its
+    // place.
+    void swapRemove(size_t index) {
+        release(slotOf[index]);
+        const size_t last = values.size() - 1;
+        if (index != last) {
+            values[index] = std::move(values[last]);
+            slotOf[index] = slotOf[last];
+            slots[slotOf[index]].index = static_cast<uint32_t>(index);
+        }
+        values.pop_back();
+        slotOf.pop_back();
+    }
+
+    // Takes back the last push_back() or emplace_back(); its handle goes
+    // stale.
+    void unpush() {
+        release(slotOf.back());
+        values.pop_back();
+        slotOf.pop_back();
+    }
+
+    // Takes back swapRemove(index) of value, whose handle becomes valid
+    // again. Only exact when everything done since has been taken back.
+    void unswapRemove(size_t index, T value, SlotHandle handle) {
+        auto free = std::find(freeSlots.rbegin(), freeSlots.rend(), handle.slot);
+        if (free != freeSlots.rend()) freeSlots.erase(std::next(free).base());
+        slots[handle.slot] = Slot{static_cast<uint32_t>(index), handle.generation};
+        if (index == values.size()) {
+            values.push_back(std::move(value));
+            slotOf.push_back(handle.slot);
+            return;
+        }
+        values.push_back(std::move(values[index]));
+        slotOf.push_back(slotOf[index]);
+        slots[slotOf.back()].index = static_cast<uint32_t>(values.size() - 1);
+        values[index] = std::move(value);
+        slotOf[index] = handle.slot;
+    }
+
+    // Removes the value at index keeping the others in order; O(n).
+    void erase(size_t index) {
+        release(slotOf[index]);
+        values.erase(values.begin() + index);
+        slotOf.erase(slotOf.begin() + index);
+        for (size_t i = index; i < slotOf.size(); ++i) {
+            slots[slotOf[i]].index = static_cast<uint32_t>(i);
+        }
+    }
+
+    // Removes everything; every outstanding handle goes stale.
+    void clear() {
+        for (uint32_t slot : slotOf) release(slot);
+        values.clear();
+        slotOf.clear();
+    }
+
+    // Replaces the contents, e.g. with a freshly loaded roster.
+    void assign(std::vector<T>&& newValues) {
+        clear();
+        values = std::move(newValues);
+        for (size_t i = 0; i < values.size(); ++i) {
+            slotOf.push_back(0);
+            uint32_t slot;
+            if (freeSlots.empty()) {
+                slot = static_cast<uint32_t>(slots.size());
+                slots.push_back(Slot{FREE, 0});
+            } else {
+                slot = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            slots[slot].index = static_cast<uint32_t>(i);
+            slotOf[i] = slot;
+        }
+    }
+};
+
+using CharacterHandle = SlotHandle;
+
+// The roster indices whose characters are eligible for promotion, kept
+// densely packed with an index -> position map beside them, so adding or
+// dropping an index is O(1) and listing them is O(number eligible).
+class EligibilityIndex {
+private:
+    std::vector<int> members;
+    std::vector<int> position; // by roster index, -1 when not eligible
+
+public:
+    void clear() {
+        members.clear();
+        position.clear();
+    }
+
+    void rebuild(const std::vector<Character>& characters) {
+        clear();
+        position.assign(characters.size(), -1);
+        for (size_t i = 0; i < characters.size(); ++i) {
+            update(static_cast<int>(i), characters[i].isEligibleForPromotion());
+        }
+    }
+
+    // Registers a character appended to the end of the roster.
+    void added(bool eligible) {
+        position.push_back(-1);
+        update(static_cast<int>(position.size()) - 1, eligible);
+    }
+
+    // Follows a roster swap-remove: index is dropped and the last
+    // character moves into its place.
+    void swapRemoved(int index) {
+        const int last = static_cast<int>(position.size()) - 1;
+        const bool lastEligible = contains(last);
+        update(index, false);
+        update(last, false);
+        position.pop_back();
+        if (index != last) update(index, lastEligible);
+    }
+
+    void update(int index, bool eligible) {
+        int& pos = position[index];
+        if (eligible && pos < 0) {
+            pos = static_cast<int>(members.size());
+            members.push_back(index);
+        } else if (!eligible && pos >= 0) {
+            const int last = members.back();
+            members[pos] = last;
+            position[last] = pos;
+            members.pop_back();
+            pos = -1;
+        }
+    }
+
+    bool contains(int index) const { return position[index] >= 0; }
+    size_t size() const { return members.size(); }
+
+    // Eligible indices in roster order.
+    std::vector<int> sorted() const {
+        std::vector<int> indices = members;
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+};
+
+// A fixed set of threads for parallel loops. run(count, fn) calls
+// fn(worker, item) for every item in [0, count), handing items out one at a
+// time to the pool threads and the calling thread (worker 0), and returns
+// once all of them are done.
+class WorkerPool {
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::function<void(int, size_t)> job;
+    size_t jobSize = 0;
+    std::atomic<size_t> nextItem{0};
+    uint64_t generation = 0;
+    int busy = 0;
+    bool stopping = false;
+
+    void work(int worker) {
+        for (size_t item; (item = nextItem.fetch_add(1)) < jobSize;) {
+            job(worker, item);
+        }
+    }
+
+    void loop(int worker) {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            lock.unlock();
+            work(worker);
+            lock.lock();
+            if (--busy == 0) done.notify_one();
+        }
+    }
+
+public:
+    explicit WorkerPool(int size) {
+        for (int worker = 1; worker < size; ++worker) {
+            threads.emplace_back(&WorkerPool::loop, this, worker);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    int size() const { return static_cast<int>(threads.size()) + 1; }
+
+    void run(size_t count, std::function<void(int, size_t)> fn) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = std::move(fn);
+            jobSize = count;
+            nextItem = 0;
+            busy = static_cast<int>(threads.size());
+            ++generation;
+        }
+        wake.notify_all();
+        work(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busy == 0; });
+    }
+};
+
+// Reads SDEWG_SAVE_v1.0 text saves: a header of format line, day and roster
+// size, then one Character::serialize() line per character. The records
+// are split into chunks on line boundaries; each chunk's newlines are
+// counted to place its first record, then the chunks are parsed on a
+// WorkerPool straight into the roster. Skill names new to the registry are
+// collected per chunk and registered in file order only once the whole
+// file has parsed, so that skill IDs do not depend on thread timing and a
+// file that fails to load leaves the registry as it was; the chunks that
+// used them are then parsed again.
+class TextSave {
+public:
+    static constexpr std::string_view MAGIC = "SDEWG_SAVE_v1.0";
+    static const size_t CHUNK_BYTES = size_t(1) << 20;
+    static const int FIRST_RECORD_LINE = 4;
+
+    // Rebuilds the roster from a mapped v1 save, on pool if one is given.
+    // Returns false and sets error, naming the line, if the file is
+    // malformed; records past the header's roster size are ignored.
+    static bool read(const char* data, size_t size, int& currentDay,
+                     std::vector<Character>& characters, std::string& error,
+                     WorkerPool* pool = nullptr) {
+        const std::string_view text(data, size);
+        size_t pos = 0;
+        int lineNumber = 0;
+        auto headerLine = [&] {
+            const size_t end = std::min(text.find('\n', pos), text.size());
+            std::string_view line = text.substr(pos, end - pos);
+            pos = std::min(end + 1, text.size());
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            return line;
+        };
+        auto headerNumber = [&](int& value) {
+            const std::string_view line = headerLine();
+            const auto parsed = std::from_chars(line.data(), line.data() + line.size(), value);
+            return parsed.ec == std::errc() && parsed.ptr == line.data() + line.size();
+        };
+        auto fail = [&](int line, const std::string& message) {
+            error = "line " + std::to_string(line) + ": " + message;
+            return false;
+        };
+
+        if (headerLine() != MAGIC) return fail(lineNumber, "not a SDEWG_SAVE_v1.0 file");
+        int day, count;
+        if (!headerNumber(day)) return fail(lineNumber, "invalid day");
+        if (!headerNumber(count) || count < 0) return fail(lineNumber, "invalid character count");
+
+        const std::string_view body = text.substr(pos);
+        std::vector<size_t> bounds{0};
+        while (bounds.back() < body.size()) {
+            const size_t end = bounds.back() + CHUNK_BYTES;
+            bounds.push_back(end >= body.size() ? body.size()
+                                                : std::min(body.find('\n', end), body.size() - 1) + 1);
+        }
+        const size_t chunkCount = bounds.size() - 1;
+        auto chunk = [&](size_t k) { return body.substr(bounds[k], bounds[k + 1] - bounds[k]); };
+        auto forEachChunk = [&](const std::function<void(int, size_t)>& fn) {
+            if (pool && chunkCount > 1) {
+                pool->run(chunkCount, fn);
+            } else {
+                for (size_t k = 0; k < chunkCount; ++k) fn(0, k);
+            }
+        };
+
+        // Number every chunk's first record
+        std::vector<size_t> firstRecord(chunkCount + 1, 0);
+        forEachChunk([&](int, size_t k) {
+            const std::string_view lines = chunk(k);
+            firstRecord[k + 1] = std::count(lines.begin(), lines.end(), '\n') + (lines.back() != '\n');
+        });
+        for (size_t k = 0; k < chunkCount; ++k) firstRecord[k + 1] += firstRecord[k];
+        if (firstRecord[chunkCount] < static_cast<size_t>(count)) {
+            return fail(FIRST_RECORD_LINE + static_cast<int>(firstRecord[chunkCount]),
+                        "expected " + std::to_string(count) + " characters, found " +
+                        std::to_string(firstRecord[chunkCount]));
+        }
+
+        // Parse each record into its slot, stopping a chunk at its first
+        // failure; known skill names only, so nothing is registered yet.
+        // The slots start without skills, so filling them allocates nothing
+        // and each record's skills are allocated by the thread parsing it.
+        Character blank{std::string()};
+        blank.restoreState(0, 1, JobLevel::INTERN, false, 0, 0, {});
+        std::vector<Character> loaded(count, blank);
+        std::vector<size_t> failedAt(chunkCount, SIZE_MAX);
+        std::vector<std::string> messages(chunkCount);
+        std::vector<SkillNameCache> chunkSkills(chunkCount, SkillNameCache(false));
+        auto parseChunk = [&](int, size_t k) {
+            std::string_view lines = chunk(k);
+            for (size_t record = firstRecord[k]; record < static_cast<size_t>(count) && !lines.empty(); ++record) {
+                const size_t end = std::min(lines.find('\n'), lines.size());
+                if (!loaded[record].parse(lines.substr(0, end), chunkSkills[k], messages[k])) {
+                    failedAt[k] = record;
+                    return;
+                }
+                lines.remove_prefix(std::min(end + 1, lines.size()));
+            }
+        };
+        forEachChunk(parseChunk);
+        for (size_t k = 0; k < chunkCount; ++k) {
+            if (failedAt[k] != SIZE_MAX) return fail(FIRST_RECORD_LINE + static_cast<int>(failedAt[k]), messages[k]);
+        }
+
+        // Register the new skill names in file order and fill them in
+        std::vector<size_t> redo;
+        for (size_t k = 0; k < chunkCount; ++k) {
+            if (chunkSkills[k].unknown().empty()) continue;
+            for (const auto& name : chunkSkills[k].unknown()) SkillRegistry::instance().intern(name);
+            redo.push_back(k);
+        }
+        if (!redo.empty()) {
+            for (size_t k : redo) chunkSkills[k] = SkillNameCache(false);
+            auto reparse = [&](int worker, size_t i) { parseChunk(worker, redo[i]); };
+            if (pool && redo.size() > 1) {
+                pool->run(redo.size(), reparse);
+            } else {
+                for (size_t i = 0; i < redo.size(); ++i) reparse(0, i);
+            }
+        }
+
+        currentDay = day;
+        characters = std::move(loaded);
+        return true;
+    }
+};
+
+// One entry of a day's schedule for attemptTaskBatch(): distinct roster
+// indices taking part in one task. An entry that repeats an index is
+// rejected, as attemptTaskMultiple() rejects it.
+struct ScheduledActivity {
+    std::vector<int> participants;
+    int taskIndex;
+};
+
+// What became of one scheduled activity.
+struct ActivityResult {
+    int32_t participants = 0; // members who still had an activity left
+    int32_t successes = 0;
+    bool anySuccess = false;
+};
+
+// One parsed line of a command script (see BasicMeetingGame::runScript()).
+// Character and task numbers are already 0-based; text points into the
+// script text the command was parsed from.
+struct ScriptCommand {
+    enum Op : uint8_t { ADD, REMOVE, ACTIVITY, PROMOTE, NEXT_DAY, SAVE, LOAD, SHOW, STATS, TASKS,
+                      FORK, COMMIT, DISCARD, ARCHIVE };
+
+    Op op;
+    int line;
+    int value;              // character or task index, days for NEXT_DAY
+    uint32_t first, count;  // ACTIVITY: its slice of ScriptBatch::participants
+    std::string_view text;  // the arguments, e.g. the name for ADD
+};
+
+// The commands parsed from one chunk of a script.
+struct ScriptBatch {
+    std::vector<ScriptCommand> commands;
+    std::vector<int> participants; // sorted distinct indices, per ACTIVITY
+    std::string error;             // set if parsing stopped at a bad line
+
+    void clear() {
+        commands.clear();
+        participants.clear();
+        error.clear();
+    }
+};
+
+// Parses command scripts in bulk: whole chunks of text are split into
+// lines and tokenized in place, with no streams and no allocation per line.
+class ScriptParser {
+private:
+    static constexpr std::string_view BLANKS = " \t\n\v\f\r";
+
+    // Reads a number the way std::atoi does: 0 when there is none.
+    static int toInt(std::string_view text) {
+        size_t start = text.find_first_not_of(BLANKS);
+        if (start == std::string_view::npos) return 0;
+        if (text[start] == '+') start++;
+        int value = 0;
+        std::from_chars(text.data() + start, text.data() + text.size(), value);
+        return value;
+    }
+
+    // A character selection such as "1,3,5" or "1 2 4", as
+    // parseCharacterSelection() reads it: digits between commas and spaces,
+    // anything else skipped.
+    static void parseSelection(std::string_view text, std::vector<int>& out) {
+        const size_t first = out.size();
+        int value = 0;
+        bool inNumber = false, overflow = false;
+        for (size_t i = 0; i <= text.size(); ++i) {
+            const char c = i < text.size() ? text[i] : ',';
+            if (c == ',' || c == ' ') {
+                if (inNumber && !overflow && value > 0) out.push_back(value - 1);
+                value = 0;
+                inNumber = overflow = false;
+            } else if (c >= '0' && c <= '9') {
+                overflow = overflow || value > (INT32_MAX - (c - '0')) / 10;
+                value = overflow ? 0 : value * 10 + (c - '0');
+                inNumber = true;
+            }
+        }
+        std::sort(out.begin() + first, out.end());
+        out.erase(std::unique(out.begin() + first, out.end()), out.end());
+    }
+
+public:
+    // Parses the lines of text, numbered from firstLine, into batch and
+    // returns the number of the line after them. At a bad line parsing
+    // stops with batch.error set; the commands before it are kept.
+    static int parse(std::string_view text, int firstLine, ScriptBatch& batch) {
+        int lineNumber = firstLine;
+        for (size_t start = 0; start < text.size(); ++lineNumber) {
+            size_t end = text.find('\n', start);
+            if (end == std::string_view::npos) end = text.size();
+            std::string_view line = text.substr(start, end - start);
+            start = end + 1;
+
+            const size_t commandStart = line.find_first_not_of(BLANKS);
+            if (commandStart == std::string_view::npos || line[commandStart] == '#') continue;
+            const size_t commandEnd = std::min(line.find_first_of(BLANKS, commandStart), line.size());
+            const std::string_view command = line.substr(commandStart, commandEnd - commandStart);
+            std::string_view args = line.substr(commandEnd);
+            args.remove_prefix(std::min(args.find_first_not_of(BLANKS), args.size()));
+            if (!args.empty() && args.back() == '\r') args.remove_suffix(1);
+
+            ScriptCommand parsed{ScriptCommand::ADD, lineNumber, 0, 0, 0, args};
+            if (command == "add") {
+                parsed.op = ScriptCommand::ADD;
+            } else if (command == "remove") {
+                parsed.op = ScriptCommand::REMOVE;
+                parsed.value = toInt(args) - 1;
+            } else if (command == "activity") {
+                const size_t split = args.find_last_of(" ,");
+                if (split == std::string_view::npos) {
+                    batch.error = "line " + std::to_string(lineNumber) + ": usage: activity <characters> <task>";
+                    return lineNumber;
+                }
+                parsed.op = ScriptCommand::ACTIVITY;
+                parsed.value = toInt(args.substr(split + 1)) - 1;
+                parsed.first = static_cast<uint32_t>(batch.participants.size());
+                parseSelection(args.substr(0, split), batch.participants);
+                parsed.count = static_cast<uint32_t>(batch.participants.size()) - parsed.first;
+            } else if (command == "promote") {
+                parsed.op = ScriptCommand::PROMOTE;
+                parsed.value = toInt(args) - 1;
+            } else if (command == "nextday") {
+                parsed.op = ScriptCommand::NEXT_DAY;
+                parsed.value = args.empty() ? 1 : toInt(args);
+            } else if (command == "save") {
+                parsed.op = ScriptCommand::SAVE;
+            } else if (command == "load") {
+                parsed.op = ScriptCommand::LOAD;
+            } else if (command == "show") {
+                parsed.op = ScriptCommand::SHOW;
+            } else if (command == "stats") {
+                parsed.op = ScriptCommand::STATS;
+                parsed.value = args.empty() ? -1 : toInt(args) - 1;
+            } else if (command == "tasks") {
+                parsed.op = ScriptCommand::TASKS;
+            } else if (command == "fork") {
+                parsed.op = ScriptCommand::FORK;
+            } else if (command == "commit") {
+                parsed.op = ScriptCommand::COMMIT;
+            } else if (command == "discard") {
+                parsed.op = ScriptCommand::DISCARD;
+            } else if (command == "archive") {
+                parsed.op = ScriptCommand::ARCHIVE;
+            } else {
+                batch.error = "line " + std::to_string(lineNumber) + ": unknown command '" +
+                              std::string(command) + "'";
+                return lineNumber;
+            }
+            batch.commands.push_back(parsed);
+        }
+        return lineNumber;
+    }
+};
+
+// The game engine, parameterized on where its dice rolls come from (see
+// RollKey). MeetingGame deals from one fast sequential stream;
+// ReproducibleMeetingGame keys every roll so simulations can be split
+// across threads without changing their results.
+template <typename Dice>
+class BasicMeetingGame {
+private:
+    SlotMap<Character> characters;
+    EligibilityIndex eligibility;
+    std::shared_ptr<const TaskCatalog> catalog; // shared, never modified
+    Dice dice;
+    uint32_t rollStream;
+    uint32_t nextCharacterId;
+    int currentDay;
+    bool headless;
+    EventSink* sink;
+    SaveJournal journal;
+    SaveArchive archive;
+
+    // Branches (see fork()). Inside a branch the roster is copy-on-write: a
+    // character is saved to the change log the first time the branch
+    // changes it, and discard() plays the log backwards. savedIn holds, by
+    // roster slot, the id of the branch that last saved its character.
+    struct RosterCopy {
+        SlotMap<Character> characters;
+        EligibilityIndex eligibility;
+        std::vector<uint32_t> savedIn;
+    };
+    struct Change {
+        enum Kind : uint8_t { TOUCHED, ADDED, REMOVED, REPLACED };
+        Kind kind;
+        int index;
+        CharacterHandle handle;
+        uint32_t savedIn;                  // the slot's savedIn before the change
+        std::optional<Character> before;   // TOUCHED and REMOVED
+        std::unique_ptr<RosterCopy> roster; // REPLACED: everything before
+    };
+    struct Savepoint {
+        uint32_t id;
+        size_t firstChange;
+        int currentDay;
+        uint32_t nextCharacterId;
+        uint32_t rollStream;
+        Dice dice;
+        std::shared_ptr<const TaskCatalog> catalog;
+    };
+    std::vector<Change> changes;
+    std::vector<Savepoint> savepoints;
+    std::vector<uint32_t> savedIn;
+    uint32_t nextBranchId = 1;
+
+    // Scratch space for one team activity, reused to avoid allocating per
+    // call. Rolls, skills and the success mask are padded for successMask().
+    struct TeamScratch {
+        std::vector<Character*> members;
+        std::vector<RollKey> keys;
+        std::vector<int32_t> rolls;
+        std::vector<int32_t> skills;
+        std::vector<int32_t> success;
+
+        void resize(size_t teamSize) {
+            keys.resize(teamSize);
+            rolls.resize(DiceRoller::padded(teamSize));
+            skills.resize(DiceRoller::padded(teamSize));
+            success.resize(DiceRoller::padded(teamSize));
+        }
+    };
+    TeamScratch team;
+    std::vector<int> scriptTeam; // an ACTIVITY command's participants
+    std::vector<uint32_t> selectedIn; // per slot, the last activity that selected it
+    uint32_t selection = 0;
+
+    // Menu lines around a paged list, and the page of it on screen
+    static const int PAGE_MENU_LINES = 8;
+    int listPage = 0;
+
+    // attemptTaskBatch() state: teams, keys, rolls and outcomes flattened
+    // across the schedule, per-character counters (all reset after each
+    // batch), the activity groups, and one scratch per pool worker
+    int workerThreads;
+    std::unique_ptr<WorkerPool> pool;
+    std::vector<TeamScratch> workerScratch;
+    std::vector<size_t> batchTeamStart;
+    std::vector<Character*> batchTeams;
+    std::vector<RollKey> batchKeys;
+    std::vector<int32_t> batchRolls;
+    std::vector<int32_t> batchSuccess;
+    std::vector<int> batchUsed;
+    std::vector<int> batchXp;
+    std::vector<int> batchLastActivity;
+    std::vector<int> batchTouched;
+    std::vector<int> batchGroup;
+    std::vector<size_t> batchGroupStart;
+    std::vector<int> batchOrder;
+    std::vector<int> batchGroups;
+
+    void emit(EventType type, std::string_view subject = {}, std::string_view detail = {},
+              int v0 = 0, int v1 = 0, int v2 = 0, int v3 = 0, std::string_view text = {}) {
+        if (sink->isEnabled()) {
+            sink->onEvent(GameEvent{type, subject, detail, text, {v0, v1, v2, v3}});
+        }
+    }
+
+    void error(std::string_view message) {
+        emit(EventType::ERROR, {}, {}, 0, 0, 0, 0, message);
+    }
+
+    int indexOf(const Character* character) const {
+        return static_cast<int>(character - characters.data());
+    }
+
+    // Skill decay and activity refreshes are applied lazily: a character
+    // is brought up to the current day only when it is read or acts, so
+    // advancing the calendar does not touch the roster. at() is for a
+    // character about to change, view() for one that is only read.
+    Character& at(int index) {
+        touch(index);
+        Character& character = characters[index];
+        character.advanceTo(currentDay);
+        return character;
+    }
+
+    const Character& view(int index) {
+        Character& character = characters[index];
+        if (character.getSyncedDay() != currentDay) {
+            touch(index);
+            character.advanceTo(currentDay);
+        }
+        return character;
+    }
+
+    void syncAll() {
+        for (size_t i = 0; i < characters.size(); ++i) {
+            view(static_cast<int>(i));
+        }
+    }
+
+    uint32_t& savedInFor(CharacterHandle handle) {
+        if (handle.slot >= savedIn.size()) savedIn.resize(handle.slot + 1, 0);
+        return savedIn[handle.slot];
+    }
+
+    // Logs a character's state before the innermost branch first changes
+    // it. Call before every change to a character already on the roster.
+    void touch(int index) {
+        if (savepoints.empty()) return;
+        const CharacterHandle handle = characters.handleAt(index);
+        uint32_t& saved = savedInFor(handle);
+        if (saved == savepoints.back().id) return;
+        changes.push_back(Change{Change::TOUCHED, index, handle, saved, characters[index], nullptr});
+        saved = savepoints.back().id;
+    }
+
+    // Log the roster changing shape inside a branch: after a character is
+    // appended, before one is swap-removed, before the roster is replaced.
+    void logAdded(CharacterHandle handle) {
+        if (savepoints.empty()) return;
+        uint32_t& saved = savedInFor(handle);
+        changes.push_back(Change{Change::ADDED, static_cast<int>(characters.size()) - 1, handle, saved,
+                                 std::nullopt, nullptr});
+        saved = savepoints.back().id;
+    }
+
+    void logRemoved(int index) {
+        if (savepoints.empty()) return;
+        const CharacterHandle handle = characters.handleAt(index);
+        changes.push_back(Change{Change::REMOVED, index, handle, savedInFor(handle),
+                                 std::move(characters[index]), nullptr});
+    }
+
+    void logReplaced() {
+        if (savepoints.empty()) return;
+        changes.push_back(Change{Change::REPLACED, 0, {}, 0, std::nullopt,
+                                 std::make_unique<RosterCopy>(RosterCopy{characters, eligibility, savedIn})});
+        // The copy covers every character from here on
+        std::fill(savedIn.begin(), savedIn.end(), savepoints.back().id);
+    }
+
+    void undo(Change& change) {
+        switch (change.kind) {
+            case Change::TOUCHED:
+                characters[change.index] = std::move(*change.before);
+                characters[change.index].setEventSink(*sink);
+                refreshEligibility(change.index);
+                savedInFor(change.handle) = change.savedIn;
+                break;
+            case Change::ADDED:
+                characters.unpush();
+                eligibility.swapRemoved(change.index);
+                savedInFor(change.handle) = change.savedIn;
+                break;
+            case Change::REMOVED:
+                characters.unswapRemove(change.index, std::move(*change.before), change.handle);
+                characters[change.index].setEventSink(*sink);
+                eligibility.added(characters.back().isEligibleForPromotion());
+                refreshEligibility(change.index);
+                savedInFor(change.handle) = change.savedIn;
+                break;
+            case Change::REPLACED:
+                characters = std::move(change.roster->characters);
+                eligibility = std::move(change.roster->eligibility);
+                savedIn = std::move(change.roster->savedIn);
+                for (auto& character : characters) {
+                    character.setEventSink(*sink);
+                }
+                break;
+        }
+    }
+
+    RollKey rollKey(const Character& character) const {
+        return RollKey{static_cast<uint32_t>(currentDay), character.getId(),
+                       static_cast<uint32_t>(character.getActivitiesUsedToday()), rollStream};
+    }
+
+    // Threads parallel work may use, including the caller.
+    int threadCount() const {
+        return workerThreads > 0 ? workerThreads : static_cast<int>(std::thread::hardware_concurrency());
+    }
+
+    // The worker pool, started on first use; null when there is only one
+    // thread to use.
+    WorkerPool* workerPool() {
+        if (threadCount() < 2) return nullptr;
+        if (!pool) pool.reset(new WorkerPool(threadCount()));
+        return pool.get();
+    }
+
+    // Gives newly joined characters ids in joining order; loaded rosters
+    // are numbered in roster order.
+    void assignIds(size_t first) {
+        for (size_t i = first; i < characters.size(); ++i) {
+            characters[i].setId(nextCharacterId++);
+        }
+    }
+
+    // Union-find over activity indices in batchGroup, merging activities
+    // that share a character.
+    int findGroup(int activity) {
+        while (batchGroup[activity] != activity) {
+            batchGroup[activity] = batchGroup[batchGroup[activity]];
+            activity = batchGroup[activity];
+        }
+        return activity;
+    }
+
+    void uniteGroups(int a, int b) {
+        a = findGroup(a);
+        b = findGroup(b);
+        if (a != b) batchGroup[std::max(a, b)] = std::min(a, b);
+    }
+
+    // Whether an in-range roster index appears more than once, in O(n).
+    bool hasRepeats(const std::vector<int>& indices) {
+        if (++selection == 0) {
+            selectedIn.assign(selectedIn.size(), 0);
+            selection = 1;
+        }
+        selectedIn.resize(characters.size(), 0);
+        for (int index : indices) {
+            if (index < 0 || index >= static_cast<int>(characters.size())) continue;
+            if (selectedIn[index] == selection) return true;
+            selectedIn[index] = selection;
+        }
+        return false;
+    }
+
+    bool runActivity(const std::vector<int>& charIndices, int taskIndex, ActivityResult& result) {
+        const auto& tasks = catalog->getTasks();
+        if (taskIndex < 0 || taskIndex >= static_cast<int>(tasks.size())) {
+            error("Invalid task selection!");
+            return false;
+        }
+
+        if (charIndices.empty()) {
+            error("No valid characters selected!");
+            return false;
+        }
+
+        // A team rolls all at once, so no one may take part twice
+        if (hasRepeats(charIndices)) {
+            error("Each character can take part in an activity only once!");
+            return false;
+        }
+
+        const MeetingTask& task = tasks[taskIndex];
+        std::vector<Character*>& availableChars = team.members;
+        availableChars.clear();
         
-        // Distinguished Engineer -> Fellow
-        promotionTasks.emplace_back("Shape Industry Standards", 
-            "Influence technical standards and practices across the industry",
-            JobLevel::DISTINGUISHED_ENGINEER, 
-            std::map<std::string, int>{{"Leadership", 12}, {"Problem_Solving", 12}, {"Presentation", 10}, {"Communication", 10}}, 45);
-    }
-
-    void initializeTasks() {
-        tasks.emplace_back("Lead Discussion", "Guide the team through a complex topic", 
-                          "Leadership", 10, 25, 2);
-        tasks.emplace_back("Present Findings", "Share research results with the group", 
-                          "Presentation", 8, 20, 2);
-        tasks.emplace_back("Resolve Conflict", "Mediate between disagreeing team members", 
-                          "Communication", 12, 30, 3);
-        tasks.emplace_back("Brainstorm Solutions", "Generate creative ideas for challenges", 
-                          "Problem_Solving", 6, 15, 1);
-        tasks.emplace_back("Coordinate Tasks", "Organize team efforts and delegate work", 
-                          "Teamwork", 9, 22, 2);
-        tasks.emplace_back("Facilitate Workshop", "Run an interactive team building session", 
-                          "Leadership", 15, 40, 3);
-        tasks.emplace_back("Document Decisions", "Create clear meeting minutes and action items", 
-                          "Communication", 5, 12, 1);
-        tasks.emplace_back("Mentor Junior Member", "Help a new team member learn the ropes", 
-                          "Teamwork", 7, 18, 2);
-    }
-
-    void addCharacter(const std::string& name) {
+        // Check which characters can participate
+        for (int index : charIndices) {
+            if (index < 0 || index >= static_cast<int>(characters.size())) continue;
+            if (view(index).canDoActivity()) {
+                touch(index);
+                availableChars.push_back(&characters[index]);
+            } else {
+                emit(EventType::NO_ACTIVITIES_LEFT, characters[index].getName());
+            }
+        }
+
+        if (availableChars.empty()) {
+            error("No characters available to do this activity!");
+            return false;
+        }
+
+        emit(EventType::ACTIVITY_STARTED, {}, task.name);
+        for (size_t i = 0; i < availableChars.size(); ++i) {
+            emit(EventType::PARTICIPANT, availableChars[i]->getName(), {},
+                 static_cast<int>(i), static_cast<int>(availableChars.size()));
+        }
+
+        int teamBonus = OutcomeOdds::teamBonus(availableChars.size());
+        if (teamBonus > 0) {
+            emit(EventType::TEAM_BONUS, {}, {}, teamBonus);
+        }
+
+        // Roll for the whole team at once
+        const size_t teamSize = availableChars.size();
+        team.resize(teamSize);
+        for (size_t i = 0; i < teamSize; ++i) {
+            team.keys[i] = rollKey(*availableChars[i]);
+        }
+        dice.roll(team.keys.data(), team.rolls.data(), teamSize);
+
+        result = resolveActivity(task, availableChars.data(), teamSize, team);
+        journalActivity(task, availableChars.data(), teamSize, team.success.data(), result.anySuccess);
+        for (Character* character : availableChars) {
+            refreshEligibility(indexOf(character));
+        }
+        return result.anySuccess;
+    }
+
+    // XP a participant earns from one activity, team bonus included.
+    static int activityXp(const MeetingTask& task, bool succeeded, bool teamSucceeded, size_t teamSize) {
+        const int bonus = teamSucceeded && teamSize > 1 ? OutcomeOdds::teamSuccessXp(teamSize) : 0;
+        return (succeeded ? task.expReward : task.expReward / 3) + bonus;
+    }
+
+    // Plays out a task for a team whose rolls are in scratch.rolls. Touches
+    // nothing but the team's characters (and the event sink), so teams with
+    // no one in common can be resolved concurrently.
+    //
+    // Each participant's rewards, team bonus included, are applied in one
+    // pass, so its level and promotion eligibility are checked once per
+    // activity. With xpByIndex the XP is instead added there by roster
+    // index, for the caller to apply once per character after a whole
+    // batch; XP never changes a roll, so the outcome is the same.
+    ActivityResult resolveActivity(const MeetingTask& task, Character* const* members,
+                                   size_t teamSize, TeamScratch& scratch, int* xpByIndex = nullptr) {
+        // Participants are distinct, so no one's outcome changes another's
+        // skill level and the whole team can be compared at once
+        const int teamBonus = OutcomeOdds::teamBonus(teamSize);
+        for (size_t i = 0; i < teamSize; ++i) {
+            scratch.skills[i] = members[i]->getSkill(task.requiredSkill);
+        }
+        DiceRoller::successMask(scratch.rolls.data(), scratch.skills.data(), task.difficulty - teamBonus,
+                                scratch.success.data(), teamSize);
+
+        ActivityResult result;
+        result.participants = static_cast<int32_t>(teamSize);
+        for (size_t i = 0; i < teamSize; ++i) {
+            result.successes += scratch.success[i] != 0;
+        }
+        result.anySuccess = result.successes > 0;
+        SDEWG_METRICS_ONLY(
+            for (size_t i = 0; i < teamSize; ++i) {
+                Metrics::rollMargin(scratch.rolls[i] + scratch.skills[i] + teamBonus - task.difficulty);
+            })
+
+        // Each character attempts the task
+        for (size_t i = 0; i < teamSize; ++i) {
+            Character* character = members[i];
+            emit(EventType::TASK_ROLL, character->getName(), skillName(task.requiredSkill),
+                 scratch.rolls[i], scratch.skills[i], teamBonus, task.difficulty);
+
+            character->useActivity();
+
+            if (scratch.success[i]) {
+                emit(EventType::TASK_SUCCEEDED, character->getName());
+            } else {
+                emit(EventType::TASK_FAILED, character->getName(), {}, task.expReward / 3);
+            }
+            const int xp = activityXp(task, scratch.success[i], result.anySuccess, teamSize);
+            if (xpByIndex) {
+                xpByIndex[indexOf(character)] += xp;
+            } else {
+                character->gainExperience(xp);
+            }
+            if (scratch.success[i]) {
+                character->improveSkill(task.requiredSkill, task.skillReward);
+            }
+        }
+        SDEWG_METRICS_ONLY(Metrics::taskAttempted(static_cast<int>(&task - catalog->getTasks().data()),
+                                                  result.participants, result.successes);)
+
+        if (result.anySuccess && teamSize > 1) {
+            emit(EventType::TEAM_XP_BONUS);
+        }
+        return result;
+    }
+
+    void journalActivity(const MeetingTask& task, Character* const* members, size_t teamSize,
+                         const int32_t* success, bool anySuccess) {
+        if (!journal.isActive()) return;
+        for (size_t i = 0; i < teamSize; ++i) {
+            const int index = indexOf(members[i]);
+            journal.record(SaveJournal::ACTIVITY_USED, index);
+            journal.record(SaveJournal::EXPERIENCE_GAINED, index,
+                           activityXp(task, success[i], anySuccess, teamSize));
+            if (success[i]) {
+                journal.record(SaveJournal::SKILL_IMPROVED, index, task.skillReward,
+                               skillName(task.requiredSkill));
+            }
+        }
+    }
+
+    void nameTaskMetrics() const {
+        SDEWG_METRICS_ONLY(
+            const auto& tasks = catalog->getTasks();
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                Metrics::nameTask(static_cast<int>(i), tasks[i].name);
+            })
+    }
+
+    // Call after anything that may flip a character's promotion flag
+    // (gaining experience, promotion).
+    void refreshEligibility(int index) {
+        eligibility.update(index, characters[index].isEligibleForPromotion());
+    }
+
+    bool writeSnapshot(const std::string& filename) {
+        const std::string temp = filename + ".tmp";
+        syncAll();
+        if (!BinarySave::write(temp, currentDay, characters.dense())) return false;
+        if (std::rename(temp.c_str(), filename.c_str()) != 0) return false;
+        return journal.startFresh(filename, SaveJournal::SnapshotInfo{
+            currentDay, static_cast<uint32_t>(characters.size()),
+            static_cast<uint64_t>(std::filesystem::file_size(filename))});
+    }
+
+    void applyJournalRecord(const SaveJournal::Record& record) {
+        const bool validIndex = record.index >= 0 && record.index < static_cast<int>(characters.size());
+        switch (record.type) {
+            case SaveJournal::DAY_ADVANCE:
+                currentDay += record.value;
+                break;
+            case SaveJournal::CHARACTER_ADDED:
+                characters.emplace_back(record.text);
+                characters.back().setEventSink(nullSink());
+                characters.back().startOnDay(currentDay);
+                assignIds(characters.size() - 1);
+                eligibility.added(false);
+                logAdded(characters.handleAt(characters.size() - 1));
+                break;
+            case SaveJournal::CHARACTER_REMOVED:
+                if (validIndex) {
+                    logReplaced();
+                    characters.erase(record.index);
+                    eligibility.rebuild(characters.dense());
+                }
+                break;
+            case SaveJournal::CHARACTER_SWAP_REMOVED:
+                if (validIndex) {
+                    logRemoved(record.index);
+                    characters.swapRemove(record.index);
+                    eligibility.swapRemoved(record.index);
+                }
+                break;
+            case SaveJournal::ACTIVITY_USED:
+                if (validIndex) at(record.index).useActivity();
+                break;
+            case SaveJournal::EXPERIENCE_GAINED:
+                if (validIndex) {
+                    at(record.index).gainExperience(record.value);
+                    refreshEligibility(record.index);
+                }
+                break;
+            case SaveJournal::SKILL_IMPROVED:
+                if (validIndex) at(record.index).improveSkill(record.text, record.value);
+                break;
+            case SaveJournal::PROMOTED:
+                if (validIndex) {
+                    at(record.index).attemptPromotion();
+                    refreshEligibility(record.index);
+                }
+                break;
+        }
+    }
+
+public:
+    // A headless game never touches the terminal: engine output is
+    // discarded and it is driven through runScript() or the engine API
+    // (addCharacter, attemptTaskMultiple, attemptPromotionTask, nextDay).
+    explicit BasicMeetingGame(bool headlessMode = false)
+        : BasicMeetingGame(headlessMode, std::random_device{}()) {}
+
+    BasicMeetingGame(bool headlessMode, uint64_t seed)
+        : catalog(TaskCatalog::builtIn()), dice(seed), rollStream(0), nextCharacterId(0), currentDay(1),
+          headless(headlessMode), sink(headlessMode ? &nullSink() : &consoleSink()),
+          workerThreads(0) {
+        nameTaskMetrics();
+    }
+
+    ~BasicMeetingGame() { stopArchive(); }
+
+    bool isHeadless() const { return headless; }
+
+    // Selects the dice stream for keyed dice policies, e.g. one stream per
+    // simulation trial; sequential dice ignore it.
+    void setRollStream(uint32_t stream) { rollStream = stream; }
+
+    // Routes all engine and character events to the given sink.
+    void setEventSink(EventSink& eventSink) {
+        sink = &eventSink;
+        for (auto& character : characters) {
+            character.setEventSink(eventSink);
+        }
+    }
+
+    EventSink& getEventSink() const { return *sink; }
+    int getCurrentDay() const { return currentDay; }
+    int getCharacterCount() const { return static_cast<int>(characters.size()); }
+
+    // A character brought up to date; O(1) however many days have passed.
+    const Character& getCharacter(int index) { return view(index); }
+
+    // The whole roster brought up to date; O(roster).
+    const std::vector<Character>& getCharacters() {
+        syncAll();
+        return characters.dense();
+    }
+
+    // Handles stay with a character as others join and leave, and go stale
+    // (indexOf() returns -1) once it leaves.
+    CharacterHandle getHandle(int index) const { return characters.handleAt(index); }
+    int indexOf(CharacterHandle handle) const { return characters.indexOf(handle); }
+    // Roster indices of the characters eligible for promotion, in roster
+    // order; O(eligible), independent of the roster size.
+    std::vector<int> getEligibleCharacters() const { return eligibility.sorted(); }
+    int getEligibleCount() const { return static_cast<int>(eligibility.size()); }
+
+    const TaskCatalog& getCatalog() const { return *catalog; }
+    const std::vector<MeetingTask>& getTasks() const { return catalog->getTasks(); }
+
+    bool loadTaskCatalog(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            error("Error: Could not open task catalog '" + filename + "'!");
+            return false;
+        }
+        std::string message;
+        TaskCatalog loaded;
+        if (!TaskCatalog::load(file, loaded, message)) {
+            error("Error: Invalid task catalog '" + filename + "', " + message);
+            return false;
+        }
+        catalog = std::make_shared<const TaskCatalog>(std::move(loaded));
+        nameTaskMetrics();
+        return true;
+    }
+
+    // Opens a branch, e.g. to try a plan out: discard() puts the roster,
+    // calendar, dice and catalog back exactly as they are now, commit()
+    // keeps the changes. Forking is O(1) and a branch costs one copy of each
+    // character it changes. Branches nest, so forking before every move
+    // gives multi-level undo. Events already reported and files already
+    // written stay; handles taken inside a discarded branch go with it.
+    void fork() {
+        savepoints.push_back(Savepoint{nextBranchId++, changes.size(), currentDay, nextCharacterId,
+                                       rollStream, dice, catalog});
+    }
+
+    // Keeps the innermost branch's changes, which become part of the
+    // enclosing branch if there is one. False if no branch is open.
+    bool commit() {
+        if (savepoints.empty()) return false;
+        const size_t first = savepoints.back().firstChange;
+        savepoints.pop_back();
+        if (savepoints.empty()) {
+            changes.clear();
+            return true;
+        }
+        // The enclosing branch now holds these saved states
+        const uint32_t enclosing = savepoints.back().id;
+        for (size_t i = first; i < changes.size(); ++i) {
+            if (changes[i].kind == Change::REPLACED) {
+                std::fill(savedIn.begin(), savedIn.end(), enclosing);
+            } else if (changes[i].kind != Change::REMOVED) {
+                savedInFor(changes[i].handle) = enclosing;
+            }
+        }
+        return true;
+    }
+
+    // Undoes everything since the innermost fork() and closes that branch;
+    // O(changes made in it). False if no branch is open.
+    bool discard() {
+        if (savepoints.empty()) return false;
+        Savepoint& savepoint = savepoints.back();
+        while (changes.size() > savepoint.firstChange) {
+            undo(changes.back());
+            changes.pop_back();
+        }
+        currentDay = savepoint.currentDay;
+        nextCharacterId = savepoint.nextCharacterId;
+        rollStream = savepoint.rollStream;
+        dice = savepoint.dice;
+        if (catalog != savepoint.catalog) {
+            catalog = std::move(savepoint.catalog);
+            nameTaskMetrics();
+        }
+        savepoints.pop_back();
+        journal.requireSnapshot(); // the journal may hold the branch's records
+        return true;
+    }
+
+    // Number of open branches.
+    int getBranchDepth() const { return static_cast<int>(savepoints.size()); }
+
+    // Drops every character and rewinds the calendar to day 1.
+    void resetRoster() {
+        logReplaced();
+        characters.clear();
+        eligibility.clear();
+        nextCharacterId = 0;
+        currentDay = 1;
+        journal.requireSnapshot(); // the journal cannot express a reset
+    }
+
+    // Returns the new member's handle, or NO_HANDLE if creation was cancelled.
+    CharacterHandle addCharacter(const std::string& name) {
         if (name.empty() || name == "cancel" || name == "exit") {
-            std::cout << "Character creation cancelled.\n";
-            return;
+            emit(EventType::CREATION_CANCELLED);
+            return SlotMap<Character>::NO_HANDLE;
+        }
+        const CharacterHandle handle = characters.emplace_back(name);
+        characters.back().setEventSink(*sink);
+        characters.back().startOnDay(currentDay);
+        assignIds(characters.size() - 1);
+        eligibility.added(false);
+        logAdded(handle);
+        journal.record(SaveJournal::CHARACTER_ADDED, -1, 0, name);
+        emit(EventType::CHARACTER_JOINED, name);
+        return handle;
+    }
+
+    // Adds a copy of an existing character, e.g. to simulate its future.
+    // The copy joins as of today; a caller that wants it charged for days
+    // it was inactive elsewhere advances it before adding it.
+    CharacterHandle addCharacter(const Character& character) {
+        const CharacterHandle handle = characters.push_back(character);
+        Character& added = characters.back();
+        added.setEventSink(*sink);
+        added.startOnDay(currentDay);
+        assignIds(characters.size() - 1);
+        eligibility.added(added.isEligibleForPromotion());
+        logAdded(handle);
+        journal.requireSnapshot(); // the journal only records new hires by name
+        return handle;
+    }
+
+    // Removes a member in O(1). The last member takes over its index; every
+    // other index is unchanged.
+    bool removeCharacterAt(int index) {
+        if (index < 0 || index >= static_cast<int>(characters.size())) {
+            return false;
         }
-        characters.emplace_back(name);
-        std::cout << name << " joined the meeting group!\n";
+        emit(EventType::CHARACTER_LEFT, characters[index].getName());
+        logRemoved(index);
+        characters.swapRemove(index);
+        eligibility.swapRemoved(index);
+        journal.record(SaveJournal::CHARACTER_SWAP_REMOVED, index);
+        return true;
+    }
+
+    // Returns false for a stale handle instead of removing someone else.
+    bool removeCharacter(CharacterHandle handle) {
+        return removeCharacterAt(characters.indexOf(handle));
     }
 
     void removeCharacter() {
@@ -384,15 +4067,22 @@ public:
         displayCharacters();
         std::cout << "\nSelect team member to remove (1-" << characters.size() 
                   << ", or 0 to cancel): ";
-        int choice;
-        std::cin >> choice;
+        std::string input;
+        std::cin >> input;
+        while (turnPage(input)) {
+            clearScreen();
+            displayCharacters();
+            std::cout << "\nSelect team member to remove (1-" << characters.size() 
+                      << ", or 0 to cancel): ";
+            std::cin >> input;
+        }
+        int choice = std::atoi(input.c_str());
 
         if (choice == 0) {
             std::cout << "Character removal cancelled.\n";
         } else if (choice >= 1 && choice <= characters.size()) {
-            std::string removedName = characters[choice - 1].getName();
-            characters.erase(characters.begin() + choice - 1);
-            std::cout << removedName << " has left the team.\n";
+            removeCharacterAt(choice - 1);
+            sink->flush();
         } else {
             std::cout << "Invalid selection!\n";
         }
@@ -402,9 +4092,43 @@ public:
         std::cin.get();
     }
 
-    void displayCharacters() const {
+    // Entries of a list that fit on one screen, all of them unless the
+    // game is drawn on a terminal.
+    static int pageSize(int linesPerEntry) {
+        TerminalRenderer* renderer = TerminalRenderer::current();
+        return renderer ? renderer->pageEntries(linesPerEntry, PAGE_MENU_LINES)
+                        : std::numeric_limits<int>::max();
+    }
+
+    // Clamps listPage to a list of count entries and returns the range of
+    // them on that page, printing the page indicator if there is more than one.
+    std::pair<int, int> listPageRange(int count, int perPage) {
+        const int pages = count > 0 ? (count - 1) / perPage + 1 : 1;
+        listPage = std::max(0, std::min(listPage, pages - 1));
+        const int first = listPage * perPage;
+        if (pages > 1) {
+            std::cout << "(Page " << listPage + 1 << "/" << pages << ", enter > or < to turn the page)\n";
+        }
+        return {first, first + std::min(perPage, count - first)};
+    }
+
+    // Moves listPage for the input ">" or "<"; false for any other input.
+    bool turnPage(const std::string& input) {
+        if (input == ">") {
+            listPage++;
+        } else if (input == "<") {
+            listPage--;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void displayCharacters() {
+        syncAll();
         std::cout << "\n=== Team Members (Day " << currentDay << ") ===\n";
-        for (size_t i = 0; i < characters.size(); ++i) {
+        const auto page = listPageRange(static_cast<int>(characters.size()), pageSize(1));
+        for (int i = page.first; i < page.second; ++i) {
             std::cout << i + 1 << ". " << characters[i].getName() 
                       << " (" << characters[i].getJobLevelString()
                       << ", Level " << characters[i].getLevel() 
@@ -417,94 +4141,93 @@ public:
     }
 
     void displayTasks() const {
+        const auto& tasks = catalog->getTasks();
         std::cout << "\n=== Available Meeting Tasks ===\n";
         for (size_t i = 0; i < tasks.size(); ++i) {
             const auto& task = tasks[i];
             std::cout << i + 1 << ". " << task.name << "\n";
             std::cout << "   " << task.description << "\n";
-            std::cout << "   Requires: " << task.requiredSkill 
+            std::cout << "   Requires: " << skillName(task.requiredSkill) 
                       << " (Difficulty: " << task.difficulty << ")\n";
             std::cout << "   Reward: " << task.expReward << " XP, +" 
-                      << task.skillReward << " " << task.requiredSkill << "\n\n";
+                      << task.skillReward << " " << skillName(task.requiredSkill) << "\n\n";
         }
     }
 
     bool attemptPromotionTask(int charIndex) {
         if (charIndex < 0 || charIndex >= characters.size()) {
-            std::cout << "Invalid character selection!\n";
+            error("Invalid character selection!");
             return false;
         }
 
-        Character& character = characters[charIndex];
+        Character& character = at(charIndex);
         
         if (!character.isEligibleForPromotion()) {
-            std::cout << character.getName() << " is not eligible for promotion yet!\n";
+            emit(EventType::NOT_ELIGIBLE, character.getName());
             return false;
         }
         
         if (!character.canDoActivity()) {
-            std::cout << character.getName() << " has no activities left today!\n";
+            emit(EventType::NO_ACTIVITIES_LEFT, character.getName());
             return false;
         }
 
-        // Find the promotion task for this character's current level
-        PromotionTask* promotionTask = nullptr;
-        for (auto& task : promotionTasks) {
-            if (task.requiredLevel == character.getJobLevel()) {
-                promotionTask = &task;
-                break;
-            }
-        }
+        const PromotionTask* promotionTask = catalog->promotionTaskFor(character.getJobLevel());
 
         if (!promotionTask) {
-            std::cout << character.getName() << " is already at the highest level!\n";
+            emit(EventType::AT_MAX_LEVEL, character.getName());
             return false;
         }
 
-        std::cout << "\n=== PROMOTION ATTEMPT ===\n";
-        std::cout << "Task: " << promotionTask->name << "\n";
-        std::cout << promotionTask->description << "\n\n";
+        emit(EventType::PROMOTION_ATTEMPT, character.getName(), promotionTask->name,
+             0, 0, 0, 0, promotionTask->description);
 
+        const RollKey key = rollKey(character);
         character.useActivity();
+        journal.record(SaveJournal::ACTIVITY_USED, charIndex);
 
         // Check skill requirements
         bool meetsRequirements = true;
-        std::cout << "Skill Requirements Check:\n";
         for (const auto& req : promotionTask->skillRequirements) {
             int currentSkill = character.getSkill(req.first);
-            std::cout << "  " << req.first << ": " << currentSkill 
-                      << "/" << req.second;
-            if (currentSkill >= req.second) {
-                std::cout << " ✓\n";
-            } else {
-                std::cout << " ✗\n";
+            emit(EventType::PROMOTION_REQUIREMENT, character.getName(), skillName(req.first),
+                 currentSkill, req.second);
+            if (currentSkill < req.second) {
                 meetsRequirements = false;
             }
         }
 
         if (!meetsRequirements) {
-            std::cout << "\nFAILED! Skills not sufficient for promotion.\n";
+            SDEWG_METRICS_ONLY(Metrics::promotionAttempted(character.getJobLevel(), Metrics::REQUIREMENTS_UNMET);)
+            emit(EventType::PROMOTION_REQUIREMENTS_UNMET, character.getName());
             character.gainExperience(25); // Consolation XP
+            refreshEligibility(charIndex);
+            journal.record(SaveJournal::EXPERIENCE_GAINED, charIndex, 25);
             return false;
         }
 
         // Roll for success
-        int roll = dice(rng);
+        int roll = dice.roll(key);
         int totalBonus = 0;
         for (const auto& req : promotionTask->skillRequirements) {
             totalBonus += character.getSkill(req.first);
         }
         
         int totalScore = roll + totalBonus;
-        std::cout << "\nPromotion Roll: " << roll << " + Skills(" << totalBonus 
-                  << ") = " << totalScore << " vs " << promotionTask->difficulty << "\n";
+        emit(EventType::PROMOTION_ROLL, character.getName(), {}, roll, totalBonus, promotionTask->difficulty);
 
         if (totalScore >= promotionTask->difficulty) {
+            SDEWG_METRICS_ONLY(Metrics::promotionAttempted(character.getJobLevel(), Metrics::PROMOTED);)
             character.attemptPromotion();
+            refreshEligibility(charIndex);
+            journal.record(SaveJournal::PROMOTED, charIndex);
             return true;
         } else {
-            std::cout << "FAILED! Not quite ready for promotion. Keep developing skills!\n";
+            SDEWG_METRICS_ONLY(Metrics::promotionAttempted(character.getJobLevel(), Metrics::ROLL_FAILED);)
+            emit(EventType::PROMOTION_ROLL_FAILED, character.getName());
             character.gainExperience(50); // Good XP for trying
+            refreshEligibility(charIndex);
+            journal.record(SaveJournal::EXPERIENCE_GAINED, charIndex, 50);
             return false;
         }
     }
@@ -520,15 +4243,20 @@ public:
         }
 
         // Show only characters eligible for promotion
-        std::vector<int> eligibleChars;
-        std::cout << "\n=== Characters Eligible for Promotion ===\n";
-        for (size_t i = 0; i < characters.size(); ++i) {
-            if (characters[i].isEligibleForPromotion()) {
-                eligibleChars.push_back(i);
-                std::cout << eligibleChars.size() << ". " << characters[i].getName() 
-                          << " (" << characters[i].getJobLevelString() << ")\n";
-            }
+        std::vector<CharacterHandle> eligibleChars;
+        for (int index : eligibility.sorted()) {
+            eligibleChars.push_back(characters.handleAt(index));
         }
+        auto displayEligible = [&] {
+            std::cout << "\n=== Characters Eligible for Promotion ===\n";
+            const auto page = listPageRange(static_cast<int>(eligibleChars.size()), pageSize(1));
+            for (int i = page.first; i < page.second; ++i) {
+                const Character& character = characters[characters.indexOf(eligibleChars[i])];
+                std::cout << i + 1 << ". " << character.getName() 
+                          << " (" << character.getJobLevelString() << ")\n";
+            }
+        };
+        displayEligible();
 
         if (eligibleChars.empty()) {
             std::cout << "No characters are eligible for promotion!\n";
@@ -541,13 +4269,23 @@ public:
 
         std::cout << "\nSelect character for promotion (1-" << eligibleChars.size() 
                   << ", or 0 to cancel): ";
-        int choice;
-        std::cin >> choice;
+        std::string input;
+        std::cin >> input;
+        while (turnPage(input)) {
+            clearScreen();
+            displayEligible();
+            std::cout << "\nSelect character for promotion (1-" << eligibleChars.size() 
+                      << ", or 0 to cancel): ";
+            std::cin >> input;
+        }
+        int choice = std::atoi(input.c_str());
 
         if (choice == 0) {
             std::cout << "Promotion cancelled.\n";
-        } else if (choice >= 1 && choice <= eligibleChars.size()) {
-            attemptPromotionTask(eligibleChars[choice - 1]);
+        } else if (choice >= 1 && choice <= eligibleChars.size() &&
+                   characters.contains(eligibleChars[choice - 1])) {
+            attemptPromotionTask(characters.indexOf(eligibleChars[choice - 1]));
+            sink->flush();
         } else {
             std::cout << "Invalid selection!\n";
         }
@@ -585,95 +4323,159 @@ public:
     }
 
     bool attemptTaskMultiple(const std::vector<int>& charIndices, int taskIndex) {
-        if (taskIndex < 0 || taskIndex >= tasks.size()) {
-            std::cout << "Invalid task selection!\n";
-            return false;
-        }
+        SDEWG_METRICS_ONLY(Metrics::Timer timer(Metrics::ATTEMPT_TASK);)
+        ActivityResult result;
+        return runActivity(charIndices, taskIndex, result);
+    }
 
-        if (charIndices.empty()) {
-            std::cout << "No valid characters selected!\n";
-            return false;
-        }
+    // Number of threads attemptTaskBatch() and loadGame() may use, including
+    // the caller; 0 (the default) means one per hardware thread.
+    void setWorkerThreads(int threads) {
+        workerThreads = threads;
+        pool.reset();
+    }
 
-        const MeetingTask& task = tasks[taskIndex];
-        std::vector<Character*> availableChars;
-        
-        // Check which characters can participate
-        for (int index : charIndices) {
-            if (characters[index].canDoActivity()) {
-                availableChars.push_back(&characters[index]);
-            } else {
-                std::cout << characters[index].getName() << " has no activities left today!\n";
+    // Plays a whole schedule of activities for the current day in one call,
+    // with exactly the results, dice rolls and journal of calling
+    // attemptTaskMultiple() on each in order; results[i] receives activity
+    // i's outcome, and out-of-range participants are ignored. Activities
+    // are grouped so that no two groups share a character, and while no
+    // events are being reported the groups run concurrently on the worker
+    // pool. Reported events must come out in schedule order, so then (or
+    // with a single thread) the activities run one after another.
+    void attemptTaskBatch(const std::vector<ScheduledActivity>& schedule,
+                          std::vector<ActivityResult>& results) {
+        SDEWG_METRICS_ONLY(Metrics::Timer timer(Metrics::ATTEMPT_TASK_BATCH);)
+        results.assign(schedule.size(), ActivityResult{});
+        if (sink->isEnabled() || schedule.size() < 2 || threadCount() < 2) {
+            for (size_t a = 0; a < schedule.size(); ++a) {
+                runActivity(schedule[a].participants, schedule[a].taskIndex, results[a]);
             }
+            return;
         }
 
-        if (availableChars.empty()) {
-            std::cout << "No characters available to do this activity!\n";
-            return false;
+        // Pick each activity's team the way sequential play would, counting
+        // the activities earlier entries use up, and key its rolls
+        const auto& tasks = catalog->getTasks();
+        const size_t activityCount = schedule.size();
+        batchTeamStart.assign(activityCount + 1, 0);
+        batchTeams.clear();
+        batchKeys.clear();
+        batchGroup.resize(activityCount);
+        batchUsed.resize(characters.size(), 0);
+        batchXp.resize(characters.size(), 0);
+        batchLastActivity.resize(characters.size(), -1);
+        batchTouched.clear();
+        for (size_t a = 0; a < activityCount; ++a) {
+            batchTeamStart[a] = batchTeams.size();
+            batchGroup[a] = static_cast<int>(a);
+            const int taskIndex = schedule[a].taskIndex;
+            if (taskIndex < 0 || taskIndex >= static_cast<int>(tasks.size())) continue;
+            if (hasRepeats(schedule[a].participants)) continue; // rejected, as in runActivity()
+            for (int index : schedule[a].participants) {
+                if (index < 0 || index >= static_cast<int>(characters.size())) continue;
+                Character& character = at(index);
+                if (character.getActivitiesLeft() - batchUsed[index] <= 0) continue;
+                RollKey key = rollKey(character);
+                key.action += batchUsed[index];
+                batchKeys.push_back(key);
+                batchTeams.push_back(&character);
+                if (batchLastActivity[index] < 0) {
+                    batchTouched.push_back(index);
+                } else {
+                    uniteGroups(batchLastActivity[index], static_cast<int>(a));
+                }
+                batchLastActivity[index] = static_cast<int>(a);
+                batchUsed[index]++;
+            }
         }
+        batchTeamStart[activityCount] = batchTeams.size();
+        batchRolls.resize(batchTeams.size());
+        batchSuccess.resize(batchTeams.size());
+        dice.roll(batchKeys.data(), batchRolls.data(), batchKeys.size());
 
-        std::cout << "\n=== Team Activity: " << task.name << " ===\n";
-        std::cout << "Participants: ";
-        for (size_t i = 0; i < availableChars.size(); ++i) {
-            std::cout << availableChars[i]->getName();
-            if (i < availableChars.size() - 1) std::cout << ", ";
+        // Order the activities by group, keeping schedule order within each
+        batchGroupStart.assign(activityCount + 1, 0);
+        for (size_t a = 0; a < activityCount; ++a) {
+            batchGroup[a] = findGroup(static_cast<int>(a));
+            batchGroupStart[batchGroup[a] + 1]++;
         }
-        std::cout << "\n\n";
-
-        // Calculate team bonus (10% per additional member, max 50%)
-        int teamBonus = std::min(4, static_cast<int>(availableChars.size() - 1)) * 2;
-        if (teamBonus > 0) {
-            std::cout << "Team Collaboration Bonus: +" << teamBonus << "\n";
+        for (size_t g = 0; g < activityCount; ++g) {
+            batchGroupStart[g + 1] += batchGroupStart[g];
+        }
+        batchOrder.resize(activityCount);
+        std::vector<size_t> fill(batchGroupStart.begin(), batchGroupStart.end() - 1);
+        for (size_t a = 0; a < activityCount; ++a) {
+            batchOrder[fill[batchGroup[a]]++] = static_cast<int>(a);
+        }
+        batchGroups.clear();
+        for (size_t g = 0; g < activityCount; ++g) {
+            if (batchGroupStart[g + 1] > batchGroupStart[g]) batchGroups.push_back(static_cast<int>(g));
         }
 
-        bool anySuccess = false;
-        
-        // Each character attempts the task
-        for (Character* character : availableChars) {
-            int roll = dice(rng);
-            int skillLevel = character->getSkill(task.requiredSkill);
-            int totalScore = roll + skillLevel + teamBonus;
+        workerPool();
+        workerScratch.resize(pool->size());
+        pool->run(batchGroups.size(), [&](int worker, size_t item) {
+            TeamScratch& scratch = workerScratch[worker];
+            const int group = batchGroups[item];
+            for (size_t i = batchGroupStart[group]; i < batchGroupStart[group + 1]; ++i) {
+                const int a = batchOrder[i];
+                const size_t first = batchTeamStart[a];
+                const size_t teamSize = batchTeamStart[a + 1] - first;
+                if (teamSize == 0) continue;
+                const MeetingTask& task = tasks[schedule[a].taskIndex];
+                scratch.resize(teamSize);
+                std::copy(&batchRolls[first], &batchRolls[first] + teamSize, scratch.rolls.begin());
+                results[a] = resolveActivity(task, &batchTeams[first], teamSize, scratch, batchXp.data());
+                std::copy(scratch.success.begin(), scratch.success.begin() + teamSize, &batchSuccess[first]);
+            }
+        });
 
-            std::cout << character->getName() << ": Roll " << roll 
-                      << " + " << task.requiredSkill << "(" << skillLevel << ")";
-            if (teamBonus > 0) std::cout << " + Team(" << teamBonus << ")";
-            std::cout << " = " << totalScore << " vs " << task.difficulty << "\n";
+        // Journal and index the outcomes in schedule order
+        for (size_t a = 0; a < activityCount; ++a) {
+            const size_t first = batchTeamStart[a];
+            const size_t teamSize = batchTeamStart[a + 1] - first;
+            if (teamSize == 0) continue;
+            journalActivity(tasks[schedule[a].taskIndex], &batchTeams[first], teamSize,
+                            &batchSuccess[first], results[a].anySuccess);
+        }
+        // Apply each character's XP for the day in one go
+        for (int index : batchTouched) {
+            characters[index].gainExperience(batchXp[index]);
+            refreshEligibility(index);
+            batchXp[index] = 0;
+            batchUsed[index] = 0;
+            batchLastActivity[index] = -1;
+        }
+    }
 
-            character->useActivity();
+    void nextDay() {
+        SDEWG_METRICS_ONLY(Metrics::Timer timer(Metrics::NEXT_DAY);)
+        advanceDays(1);
+    }
 
-            if (totalScore >= task.difficulty) {
-                std::cout << "  SUCCESS! ";
-                character->gainExperience(task.expReward);
-                character->improveSkill(task.requiredSkill, task.skillReward);
-                anySuccess = true;
-            } else {
-                std::cout << "  FAILED! " << character->getName() 
-                          << " gains " << (task.expReward / 3) << " XP for trying.\n";
-                character->gainExperience(task.expReward / 3);
-            }
+    // Moves the calendar forward in O(1): characters catch up lazily and
+    // end up exactly as if nextDay() had run n times. When events are being
+    // reported the roster is brought up to date right away, so that decay
+    // is reported on the day it happens.
+    void advanceDays(int days) {
+        if (days <= 0) return;
+        if (archive.isOpen() && !archive.append(currentDay, characters.dense())) {
+            error("Error: Could not write to the archive!");
         }
-
-        // Additional team success bonus
-        if (anySuccess && availableChars.size() > 1) {
-            std::cout << "\nTeam activity bonus XP granted to all participants!\n";
-            for (Character* character : availableChars) {
-                character->gainExperience(5 * (availableChars.size() - 1));
-            }
+        currentDay += days;
+        journal.record(SaveJournal::DAY_ADVANCE, -1, days);
+        emit(EventType::DAY_STARTED, {}, {}, currentDay);
+        if (sink->isEnabled()) {
+            syncAll();
         }
-
-        return anySuccess;
+        emit(EventType::ACTIVITIES_REFRESHED);
     }
 
-    void nextDay() {
-        currentDay++;
+    void nextDayMenu() {
         clearScreen();
-        std::cout << "=== Day " << currentDay << " begins! ===\n";
-        
-        for (auto& character : characters) {
-            character.newDay();
-        }
-        
-        std::cout << "All team members have refreshed their daily activities.\n";
+        nextDay();
+        sink->flush();
         std::cout << "Press Enter to continue...";
         std::cin.ignore();
         std::cin.get();
@@ -694,6 +4496,12 @@ public:
         std::string charInput;
         std::cin.ignore();
         std::getline(std::cin, charInput);
+        while (turnPage(charInput)) {
+            clearScreen();
+            displayCharacters();
+            std::cout << "\nSelect team member(s) (e.g., '1' or '1,3,5' or '1 2 4'): ";
+            std::getline(std::cin, charInput);
+        }
         
         std::vector<int> selectedChars = parseCharacterSelection(charInput);
         
@@ -705,11 +4513,12 @@ public:
         }
 
         displayTasks();
-        std::cout << "Select task (1-" << tasks.size() << "): ";
+        std::cout << "Select task (1-" << catalog->getTasks().size() << "): ";
         int taskChoice;
         std::cin >> taskChoice;
 
         attemptTaskMultiple(selectedChars, taskChoice - 1);
+        sink->flush();
         
         std::cout << "\nPress Enter to continue...";
         std::cin.ignore();
@@ -726,6 +4535,22 @@ public:
             return;
         }
         
+        syncAll();
+        const int perPage = pageSize(7 + CORE_SKILL_COUNT); // lines of displayStats()
+        if (static_cast<int>(characters.size()) > perPage) {
+            std::cin.ignore();
+            std::string input;
+            do {
+                clearScreen();
+                const auto page = listPageRange(static_cast<int>(characters.size()), perPage);
+                for (int i = page.first; i < page.second; ++i) {
+                    characters[i].displayStats();
+                }
+                std::cout << "\nPress Enter to continue...";
+            } while (std::getline(std::cin, input) && turnPage(input));
+            return;
+        }
+
         for (const auto& character : characters) {
             character.displayStats();
         }
@@ -735,13 +4560,43 @@ public:
         std::cin.get();
     }
 
-    bool saveGame(const std::string& filename) {
+    bool saveGame(const std::string& filename, SaveFormat format = SaveFormat::JOURNALED) {
+        SDEWG_METRICS_ONLY(Metrics::Timer timer(Metrics::SAVE_GAME);)
+        if (format == SaveFormat::JOURNALED) {
+            // Append to the journal when it already extends this snapshot,
+            // otherwise (or once it has grown too large) compact into a
+            // fresh snapshot.
+            bool saved = (journal.isActive() && journal.getSnapshotPath() == filename &&
+                          !journal.needsCompaction())
+                             ? journal.flush()
+                             : writeSnapshot(filename);
+            if (!saved) {
+                error("Error: Could not write save file '" + filename + "'!");
+                return false;
+            }
+            emit(EventType::GAME_SAVED, filename);
+            return true;
+        }
+
+        journal.unbind();
+        if (format == SaveFormat::BINARY_V2) {
+            syncAll();
+            if (!BinarySave::write(filename, currentDay, characters.dense())) {
+                error("Error: Could not write save file '" + filename + "'!");
+                return false;
+            }
+            emit(EventType::GAME_SAVED, filename);
+            return true;
+        }
+
         std::ofstream file(filename);
         if (!file.is_open()) {
-            std::cout << "Error: Could not create save file '" << filename << "'!\n";
+            error("Error: Could not create save file '" + filename + "'!");
             return false;
         }
 
+        syncAll();
+
         // Save game metadata
         file << "SDEWG_SAVE_v1.0\n";
         file << currentDay << "\n";
@@ -753,44 +4608,110 @@ public:
         }
 
         file.close();
-        std::cout << "Game saved to '" << filename << "'!\n";
+        emit(EventType::GAME_SAVED, filename);
         return true;
     }
 
     bool loadGame(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cout << "Error: Could not open save file '" << filename << "'!\n";
-            return false;
+        SDEWG_METRICS_ONLY(Metrics::Timer timer(Metrics::LOAD_GAME);)
+        {
+            MappedFile mapped(filename);
+            if (!mapped.isOpen()) {
+                error("Error: Could not open save file '" + filename + "'!");
+                return false;
+            }
+            if (BinarySave::isBinarySave(mapped.data(), mapped.size())) {
+                std::string error;
+                std::vector<Character> loaded;
+                if (!BinarySave::read(mapped.data(), mapped.size(), currentDay, loaded, error)) {
+                    this->error("Error: " + error + "!");
+                    return false;
+                }
+                logReplaced();
+                characters.assign(std::move(loaded));
+                journal.unbind();
+                const SaveJournal::SnapshotInfo info{
+                    currentDay, static_cast<uint32_t>(characters.size()), mapped.size()};
+                for (auto& character : characters) {
+                    character.setEventSink(nullSink());
+                    character.startOnDay(currentDay);
+                }
+                nextCharacterId = 0;
+                assignIds(0);
+                eligibility.rebuild(characters.dense());
+                journal.replay(filename, info, [this](const SaveJournal::Record& record) {
+                    applyJournalRecord(record);
+                });
+                for (auto& character : characters) {
+                    character.setEventSink(*sink);
+                }
+                eligibility.rebuild(characters.dense());
+                emit(EventType::GAME_LOADED, filename, {}, currentDay, static_cast<int>(characters.size()));
+                return true;
+            }
+
+            // Otherwise the SDEWG_SAVE_v1.0 text format
+            std::string message;
+            std::vector<Character> loaded;
+            int day = currentDay;
+            WorkerPool* workers = mapped.size() > TextSave::CHUNK_BYTES ? workerPool() : nullptr;
+            if (!TextSave::read(mapped.data(), mapped.size(), day, loaded, message, workers)) {
+                error("Error: Invalid save file '" + filename + "', " + message + "!");
+                return false;
+            }
+            logReplaced();
+            journal.unbind();
+            currentDay = day;
+            characters.assign(std::move(loaded));
         }
+        for (auto& character : characters) {
+            character.setEventSink(*sink);
+            character.startOnDay(currentDay);
+        }
+        nextCharacterId = 0;
+        assignIds(0);
+        eligibility.rebuild(characters.dense());
+        emit(EventType::GAME_LOADED, filename, {}, currentDay, static_cast<int>(characters.size()));
+        return true;
+    }
 
-        std::string line;
-        
-        // Check file format
-        std::getline(file, line);
-        if (line != "SDEWG_SAVE_v1.0") {
-            std::cout << "Error: Invalid save file format!\n";
-            file.close();
+    // Records the roster into a SaveArchive as each day ends, from now until
+    // stopArchive() or the end of the game.
+    bool startArchive(const std::string& filename, int keyframeInterval = SaveArchive::DEFAULT_KEYFRAME_INTERVAL) {
+        stopArchive();
+        if (!archive.open(filename, keyframeInterval)) {
+            error("Error: Could not create archive '" + filename + "'!");
             return false;
         }
+        return true;
+    }
 
-        // Load game metadata
-        std::getline(file, line);
-        currentDay = std::stoi(line);
-
-        std::getline(file, line);
-        int numCharacters = std::stoi(line);
+    // Records the day in progress and finishes the archive.
+    bool stopArchive() {
+        if (!archive.isOpen()) return true;
+        const bool appended = archive.append(currentDay, characters.dense());
+        return archive.close() && appended;
+    }
 
-        // Clear existing characters and load from file
-        characters.clear();
-        for (int i = 0; i < numCharacters; ++i) {
-            std::getline(file, line);
-            characters.push_back(Character::deserialize(line));
+    // Loads the roster as it stood on a day recorded in an archive.
+    bool loadArchivedDay(const std::string& filename, int day) {
+        std::vector<Character> loaded;
+        std::string message;
+        if (!SaveArchive::read(filename, day, loaded, message)) {
+            error("Error: " + message + "!");
+            return false;
         }
-
-        file.close();
-        std::cout << "Game loaded from '" << filename << "'!\n";
-        std::cout << "Day " << currentDay << " - " << characters.size() << " team members loaded.\n";
+        journal.unbind();
+        logReplaced();
+        characters.assign(std::move(loaded));
+        currentDay = day;
+        for (auto& character : characters) {
+            character.setEventSink(*sink);
+        }
+        nextCharacterId = 0;
+        assignIds(0);
+        eligibility.rebuild(characters.dense());
+        emit(EventType::GAME_LOADED, filename, {}, currentDay, static_cast<int>(characters.size()));
         return true;
     }
 
@@ -803,7 +4724,9 @@ public:
         std::getline(std::cin, filename);
         filename += ".sav";
 
-        if (saveGame(filename)) {
+        bool saved = saveGame(filename);
+        sink->flush();
+        if (saved) {
             std::cout << "Save successful!\n";
         } else {
             std::cout << "Save failed!\n";
@@ -822,17 +4745,135 @@ public:
         std::getline(std::cin, filename);
         filename += ".sav";
 
-        if (loadGame(filename)) {
+        bool loaded = loadGame(filename);
+        sink->flush();
+        if (loaded) {
             std::cout << "Load successful!\n";
         } else {
             std::cout << "Load failed!\n";
         }
 
-        std::cout << "Press Enter to continue...";
-        std::cin.get();
+        std::cout << "Press Enter to continue...";
+        std::cin.get();
+    }
+
+    // Runs a line-oriented command script against the engine without any
+    // prompts. Supported commands (character and task numbers are 1-based):
+    //   add <name>
+    //   remove <character>
+    //   activity <characters> <task>   e.g. "activity 1,3,5 2"
+    //   promote <character>
+    //   nextday [count]
+    //   save <file> / load <file>
+    //   show / stats [character] / tasks   print the roster, character
+    //                                      stats or task list right away
+    //   fork / commit / discard   open a branch, keep it or undo it
+    //   archive <file>   record every day from here on (see SaveArchive)
+    // Blank lines and lines starting with '#' are ignored. The script is
+    // read and parsed a chunk at a time, so stdin, files and pipes all run
+    // at engine speed; nothing is printed except events (if the sink shows
+    // them) and what the show, stats and tasks commands ask for.
+    bool runScript(std::istream& in) {
+        bool ok = runScriptLines(in);
+        sink->flush();
+        return ok;
+    }
+
+    bool runScriptLines(std::istream& in) {
+        static const size_t CHUNK_SIZE = 1 << 16;
+        std::string text;
+        ScriptBatch batch;
+        int nextLine = 1;
+        while (true) {
+            const size_t kept = text.size();
+            text.resize(kept + CHUNK_SIZE);
+            in.read(&text[kept], CHUNK_SIZE);
+            text.resize(kept + static_cast<size_t>(in.gcount()));
+            const bool atEnd = !in;
+
+            // Only whole lines are parsed; a partial one waits for the next chunk
+            const size_t complete = atEnd ? text.size() : text.rfind('\n') + 1;
+            batch.clear();
+            nextLine = ScriptParser::parse(std::string_view(text).substr(0, complete), nextLine, batch);
+            for (const auto& command : batch.commands) {
+                if (!runCommand(command, batch)) return false;
+            }
+            if (!batch.error.empty()) {
+                std::cerr << batch.error << "\n";
+                return false;
+            }
+            if (atEnd) return true;
+            text.erase(0, complete);
+        }
+    }
+
+    bool runCommand(const ScriptCommand& command, const ScriptBatch& batch) {
+        switch (command.op) {
+            case ScriptCommand::ADD:
+                addCharacter(std::string(command.text));
+                return true;
+            case ScriptCommand::REMOVE:
+                if (!removeCharacterAt(command.value)) {
+                    std::cerr << "line " << command.line << ": invalid character '" << command.text << "'\n";
+                    return false;
+                }
+                return true;
+            case ScriptCommand::ACTIVITY:
+                scriptTeam.clear();
+                for (uint32_t i = 0; i < command.count; ++i) {
+                    const int index = batch.participants[command.first + i];
+                    if (index < static_cast<int>(characters.size())) scriptTeam.push_back(index);
+                }
+                attemptTaskMultiple(scriptTeam, command.value);
+                return true;
+            case ScriptCommand::PROMOTE:
+                attemptPromotionTask(command.value);
+                return true;
+            case ScriptCommand::NEXT_DAY:
+                advanceDays(command.value);
+                return true;
+            case ScriptCommand::SAVE:
+                return saveGame(std::string(command.text));
+            case ScriptCommand::LOAD:
+                return loadGame(std::string(command.text));
+            case ScriptCommand::SHOW:
+                sink->flush();
+                displayCharacters();
+                return true;
+            case ScriptCommand::STATS:
+                sink->flush();
+                if (command.value < 0) {
+                    syncAll();
+                    for (const auto& character : characters) character.displayStats();
+                } else if (command.value < static_cast<int>(characters.size())) {
+                    view(command.value).displayStats();
+                } else {
+                    std::cerr << "line " << command.line << ": invalid character '" << command.text << "'\n";
+                    return false;
+                }
+                return true;
+            case ScriptCommand::TASKS:
+                sink->flush();
+                displayTasks();
+                return true;
+            case ScriptCommand::FORK:
+                fork();
+                return true;
+            case ScriptCommand::ARCHIVE:
+                return startArchive(std::string(command.text));
+            case ScriptCommand::COMMIT:
+            case ScriptCommand::DISCARD:
+                if (!(command.op == ScriptCommand::COMMIT ? commit() : discard())) {
+                    std::cerr << "line " << command.line << ": no branch is open\n";
+                    return false;
+                }
+                return true;
+        }
+        return false;
     }
 
     void runGame() {
+        TerminalRenderer renderer(std::cout, std::cin);
         clearScreen();
         std::cout << "=== Welcome to SDEWG RPG ===\n";
         std::cout << "Build your team and level up through meeting challenges!\n";
@@ -843,6 +4884,7 @@ public:
 
         while (true) {
             clearScreen();
+            listPage = 0;
             std::cout << "\n=== SDEWG RPG - Day " << currentDay << " ===\n";
             std::cout << "1. Add Team Member\n";
             std::cout << "2. Remove Team Member\n";
@@ -867,6 +4909,7 @@ public:
                     std::cin.ignore(); // Clear any leftover newline
                     std::getline(std::cin, name);
                     addCharacter(name);
+                    sink->flush();
                     std::cout << "Press Enter to continue...";
                     std::cin.get();
                     break;
@@ -891,7 +4934,7 @@ public:
                     std::cin.get();
                     break;
                 case 7:
-                    nextDay();
+                    nextDayMenu();
                     break;
                 case 8:
                     saveGameMenu();
@@ -910,8 +4953,991 @@ public:
     }
 };
 
-int main() {
-    MeetingGame game;
+using MeetingGame = BasicMeetingGame<DiceRoller>;
+using ReproducibleMeetingGame = BasicMeetingGame<CounterDice>;
+
+// Decides what one character does on one simulated day. It is called once
+// per day with the character's roster index and should spend its activities
+// through the engine API.
+using ActivityPolicy = std::function<void(ReproducibleMeetingGame&, int)>;
+
+// Attempts promotion whenever eligible, otherwise repeats one meeting task.
+ActivityPolicy repeatTaskPolicy(int taskIndex) {
+    return [taskIndex](ReproducibleMeetingGame& game, int charIndex) {
+        const std::vector<int> team{charIndex};
+        while (game.getCharacter(charIndex).canDoActivity()) {
+            if (game.getCharacter(charIndex).isEligibleForPromotion()) {
+                game.attemptPromotionTask(charIndex);
+            } else {
+                game.attemptTaskMultiple(team, taskIndex);
+            }
+        }
+    };
+}
+
+// Trains the skill furthest below the next promotion task's requirement,
+// then farms the most rewarding task and attempts promotion once eligible.
+ActivityPolicy trainForPromotionPolicy() {
+    return [](ReproducibleMeetingGame& game, int charIndex) {
+        const std::vector<int> team{charIndex};
+        const auto& tasks = game.getTasks();
+        while (game.getCharacter(charIndex).canDoActivity()) {
+            const Character& character = game.getCharacter(charIndex);
+            const PromotionTask* next = game.getCatalog().promotionTaskFor(character.getJobLevel());
+            if (!next) return; // already a Fellow
+
+            SkillId weakest = -1;
+            int worstDeficit = 0;
+            for (const auto& req : next->skillRequirements) {
+                int deficit = req.second - character.getSkill(req.first);
+                if (deficit > worstDeficit) {
+                    worstDeficit = deficit;
+                    weakest = req.first;
+                }
+            }
+            if (weakest < 0 && character.isEligibleForPromotion()) {
+                game.attemptPromotionTask(charIndex);
+                continue;
+            }
+
+            // Only the tasks that train the weakest skill are candidates
+            std::vector<int> candidates = game.getCatalog().tasksForSkill(weakest);
+            if (candidates.empty()) {
+                for (size_t i = 0; i < tasks.size(); ++i) candidates.push_back(static_cast<int>(i));
+            }
+            int best = 0;
+            double bestValue = -1.0;
+            for (int i : candidates) {
+                double value = OutcomeOdds::task(tasks[i], character).expectedXp;
+                if (value > bestValue) {
+                    bestValue = value;
+                    best = i;
+                }
+            }
+            game.attemptTaskMultiple(team, best);
+        }
+    };
+}
+
+// One promotion of a CareerPlan: train each target skill up to its value,
+// farm XP on the grind task until eligible, then attempt the promotion task
+// until it succeeds. Targets are at or above the promotion task's
+// requirements; training past them buys better odds on the promotion roll.
+struct StagePlan {
+    JobLevel from;
+    int grindTask;
+    std::vector<std::pair<SkillId, int>> skillTargets;
+    double expectedActivities;
+};
+
+// The fastest way found from a character's current state to a job level,
+// with the expected activities along the way.
+struct CareerPlan {
+    static constexpr int PROMOTE = -1; // schedule entry for a promotion attempt
+
+    JobLevel target = JobLevel::FELLOW;
+    bool reachable = false;
+    double expectedActivities = 0.0;
+    std::vector<StagePlan> stages;
+    // Day-by-day schedule along the expected path: the task index (or
+    // PROMOTE) of every activity, each expected attempt rounded to a whole one
+    std::vector<std::vector<int>> days;
+
+    double expectedDays() const { return expectedActivities / Character::MAX_ACTIVITIES_PER_DAY; }
+
+    const StagePlan* stageFor(JobLevel level) const {
+        for (const auto& stage : stages) {
+            if (stage.from == level) return &stage;
+        }
+        return nullptr;
+    }
+
+    // Writes the schedule as a runScript() script for the given (1-based)
+    // character number.
+    void writeScript(std::ostream& out, int character) const {
+        for (size_t day = 0; day < days.size(); ++day) {
+            out << "# Day " << day + 1 << "\n";
+            for (int activity : days[day]) {
+                if (activity == PROMOTE) {
+                    out << "promote " << character << "\n";
+                } else {
+                    out << "activity " << character << " " << activity + 1 << "\n";
+                }
+            }
+            out << "nextday\n";
+        }
+    }
+};
+
+// Plans the schedule that minimizes the expected activities, and so days,
+// a character needs to reach a job level. Decay never comes into it: a plan
+// keeps the character busy every day.
+//
+// A stage is planned in expectation: an attempt at a task is worth its
+// expected XP and a skill gain arrives after the expected 1/p attempts, so
+// every stage plan leads to one (skills, XP) state. The search runs a level
+// at a time: every state on the frontier is expanded with every stage plan
+// (grind task x extra training per required skill) on a WorkerPool, states
+// reached more than one way keep only their cheapest path, and the
+// BEAM_WIDTH most promising carry on, ranked by activities spent minus XP
+// banked at the best rate any task pays.
+class CareerPlanner {
+public:
+    static const int MAX_EXTRA_TRAINING = 2; // skill points past a requirement
+    static const int BEAM_WIDTH = 256;
+
+private:
+    struct Node {
+        std::vector<int> skills; // indexed by SkillId
+        double xp;
+        double activities;
+        int parent; // index into the previous level's frontier, -1 at the start
+        StagePlan stage;
+    };
+
+    const TaskCatalog& catalog;
+    double bestXpRate = 1.0;
+
+    // Plays a stage out in expectation, updating skills, xp and activities.
+    // Returns false if it can never finish, i.e. some roll it needs cannot
+    // succeed. steps, if given, receives each activity kind with its
+    // expected number of attempts.
+    bool playStage(const StagePlan& stage, std::vector<int>& skills, double& xp, double& activities,
+                   std::vector<std::pair<int, double>>* steps) const {
+        const auto& tasks = catalog.getTasks();
+        const PromotionTask* promotion = catalog.promotionTaskFor(stage.from);
+        if (!promotion) return false;
+
+        // Attempts a task until it succeeds once
+        auto succeedAt = [&](int taskIndex) {
+            const MeetingTask& task = tasks[taskIndex];
+            const double p = OutcomeOdds::task(task.difficulty, task.expReward, task.skillReward,
+                                               skills[task.requiredSkill], 1).success;
+            if (p == 0.0) return false;
+            const double attempts = 1.0 / p;
+            activities += attempts;
+            xp += task.expReward + (attempts - 1.0) * (task.expReward / 3);
+            skills[task.requiredSkill] += task.skillReward;
+            if (steps) steps->emplace_back(taskIndex, attempts);
+            return true;
+        };
+
+        for (const auto& target : stage.skillTargets) {
+            while (skills[target.first] < target.second) {
+                const int trainer = trainerFor(catalog, target.first, skills[target.first]);
+                if (trainer < 0 || !succeedAt(trainer)) return false;
+            }
+        }
+
+        const double threshold = Character::getPromotionRequirement(stage.from);
+        const MeetingTask& grind = tasks[stage.grindTask];
+        while (xp < threshold) {
+            const auto odds = OutcomeOdds::task(grind.difficulty, grind.expReward, grind.skillReward,
+                                                skills[grind.requiredSkill], 1);
+            if (odds.success == 0.0) return false;
+            const double untilSuccess = grind.expReward + (1.0 / odds.success - 1.0) * (grind.expReward / 3);
+            if (xp + untilSuccess >= threshold) {
+                // Eligible part-way to the next success
+                const double attempts = (threshold - xp) / odds.expectedXp;
+                activities += attempts;
+                xp = threshold;
+                if (steps) steps->emplace_back(stage.grindTask, attempts);
+                break;
+            }
+            succeedAt(stage.grindTask);
+        }
+
+        int totalBonus = 0;
+        for (const auto& req : promotion->skillRequirements) {
+            if (skills[req.first] < req.second) return false;
+            totalBonus += skills[req.first];
+        }
+        const double p = OutcomeOdds::chance(OutcomeOdds::successFaces(promotion->difficulty - totalBonus));
+        if (p == 0.0) return false;
+        const double attempts = 1.0 / p;
+        activities += attempts;
+        xp += 100 + (attempts - 1.0) * 50;
+        for (int& value : skills) {
+            if (value > 0) value += 1;
+        }
+        if (steps) steps->emplace_back(CareerPlan::PROMOTE, attempts);
+        return true;
+    }
+
+    // Every stage plan for promoting out of a level, played from one node.
+    void expand(const Node& node, int parent, JobLevel level, std::vector<Node>& children) const {
+        const PromotionTask* promotion = catalog.promotionTaskFor(level);
+        if (!promotion) return;
+        const auto& reqs = promotion->skillRequirements;
+        int combinations = 1;
+        for (size_t i = 0; i < reqs.size(); ++i) combinations *= MAX_EXTRA_TRAINING + 1;
+
+        for (int grind = 0; grind < static_cast<int>(catalog.getTasks().size()); ++grind) {
+            for (int combination = 0; combination < combinations; ++combination) {
+                Node child{node.skills, node.xp, node.activities, parent, {level, grind, {}, 0.0}};
+                // Every requirement stays a target even when the expected
+                // path meets it anyway, so that the plan trains it when the
+                // real dice fall short
+                int extras = combination;
+                bool trainsMore = combination == 0;
+                for (const auto& req : reqs) {
+                    const int target = req.second + extras % (MAX_EXTRA_TRAINING + 1);
+                    extras /= MAX_EXTRA_TRAINING + 1;
+                    child.stage.skillTargets.emplace_back(req.first, target);
+                    trainsMore = trainsMore || node.skills[req.first] < target;
+                }
+                // Extra training the character already has is the same plan
+                if (!trainsMore) continue;
+                if (playStage(child.stage, child.skills, child.xp, child.activities, nullptr)) {
+                    child.stage.expectedActivities = child.activities - node.activities;
+                    children.push_back(std::move(child));
+                }
+            }
+        }
+    }
+
+public:
+    explicit CareerPlanner(const TaskCatalog& taskCatalog) : catalog(taskCatalog) {
+        for (const auto& task : catalog.getTasks()) {
+            bestXpRate = std::max(bestXpRate, static_cast<double>(task.expReward));
+        }
+    }
+
+    // The task that trains a skill fastest from its current value: most
+    // expected skill points per attempt, then most XP. -1 if none can
+    // succeed.
+    static int trainerFor(const TaskCatalog& catalog, SkillId skill, int value) {
+        int best = -1;
+        double bestGain = 0.0, bestXp = 0.0;
+        for (int i : catalog.tasksForSkill(skill)) {
+            const MeetingTask& task = catalog.getTasks()[i];
+            const auto odds = OutcomeOdds::task(task.difficulty, task.expReward, task.skillReward, value, 1);
+            if (odds.expectedSkill > bestGain || (odds.expectedSkill == bestGain && odds.expectedXp > bestXp)) {
+                best = odds.expectedSkill > 0.0 ? i : best;
+                bestGain = odds.expectedSkill;
+                bestXp = odds.expectedXp;
+            }
+        }
+        return best;
+    }
+
+    CareerPlan plan(const Character& start, JobLevel target, int threads = 0) const {
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        CareerPlan result;
+        result.target = target;
+
+        std::vector<int> skills = start.getSkills();
+        skills.resize(std::max(skills.size(), static_cast<size_t>(SkillRegistry::instance().size())), 0);
+        std::vector<std::vector<Node>> frontiers;
+        frontiers.push_back({Node{skills, static_cast<double>(start.getExperience()), 0.0, -1, {}}});
+
+        WorkerPool pool(threads);
+        for (int level = static_cast<int>(start.getJobLevel()); level < static_cast<int>(target); ++level) {
+            const std::vector<Node>& frontier = frontiers.back();
+            std::vector<std::vector<Node>> children(frontier.size());
+            pool.run(frontier.size(), [&](int, size_t i) {
+                expand(frontier[i], static_cast<int>(i), static_cast<JobLevel>(level), children[i]);
+            });
+
+            // Keep the cheapest path to every state
+            std::map<std::pair<std::vector<int>, long long>, Node> cheapest;
+            for (auto& group : children) {
+                for (auto& child : group) {
+                    auto key = std::make_pair(child.skills, std::llround(child.xp));
+                    auto found = cheapest.find(key);
+                    if (found == cheapest.end()) {
+                        cheapest.emplace(std::move(key), std::move(child));
+                    } else if (child.activities < found->second.activities) {
+                        found->second = std::move(child);
+                    }
+                }
+            }
+            if (cheapest.empty()) return result; // some promotion can never be won
+
+            std::vector<Node> next;
+            next.reserve(cheapest.size());
+            for (auto& entry : cheapest) next.push_back(std::move(entry.second));
+            auto score = [this](const Node& node) { return node.activities - node.xp / bestXpRate; };
+            std::stable_sort(next.begin(), next.end(),
+                             [&](const Node& a, const Node& b) { return score(a) < score(b); });
+            if (next.size() > static_cast<size_t>(BEAM_WIDTH)) next.resize(BEAM_WIDTH);
+            frontiers.push_back(std::move(next));
+        }
+
+        // Walk back from the cheapest finish to collect its stages
+        const auto& last = frontiers.back();
+        int index = static_cast<int>(std::min_element(last.begin(), last.end(),
+                                                      [](const Node& a, const Node& b) {
+                                                          return a.activities < b.activities;
+                                                      }) - last.begin());
+        result.reachable = true;
+        result.expectedActivities = last[index].activities;
+        for (size_t level = frontiers.size() - 1; level > 0; --level) {
+            result.stages.push_back(frontiers[level][index].stage);
+            index = frontiers[level][index].parent;
+        }
+        std::reverse(result.stages.begin(), result.stages.end());
+
+        // Replay the stages to lay out the expected path day by day
+        double xp = start.getExperience(), activities = 0.0;
+        std::vector<std::pair<int, double>> steps;
+        for (const auto& stage : result.stages) {
+            playStage(stage, skills, xp, activities, &steps);
+        }
+        double expected = 0.0;
+        long long scheduled = 0;
+        for (const auto& step : steps) {
+            expected += step.second;
+            for (; scheduled < std::llround(expected); ++scheduled) {
+                if (scheduled % Character::MAX_ACTIVITIES_PER_DAY == 0) result.days.emplace_back();
+                result.days.back().push_back(step.first);
+            }
+        }
+        return result;
+    }
+};
+
+// Follows a CareerPlan on the real dice. At each level it trains any skill
+// below the stage's target, attempts promotion once eligible and otherwise
+// farms the grind task; past the plan's target it does nothing.
+ActivityPolicy plannedPolicy(CareerPlan plan) {
+    return [plan = std::move(plan)](ReproducibleMeetingGame& game, int charIndex) {
+        const std::vector<int> team{charIndex};
+        while (game.getCharacter(charIndex).canDoActivity()) {
+            const Character& character = game.getCharacter(charIndex);
+            const StagePlan* stage = plan.stageFor(character.getJobLevel());
+            if (!stage) return;
+
+            int trainer = -1;
+            for (const auto& target : stage->skillTargets) {
+                const int value = character.getSkill(target.first);
+                if (value < target.second) {
+                    trainer = CareerPlanner::trainerFor(game.getCatalog(), target.first, value);
+                    break;
+                }
+            }
+            if (trainer >= 0) {
+                game.attemptTaskMultiple(team, trainer);
+            } else if (character.isEligibleForPromotion()) {
+                game.attemptPromotionTask(charIndex);
+            } else {
+                game.attemptTaskMultiple(team, stage->grindTask);
+            }
+        }
+    };
+}
+
+// Distribution of the day on which a character first reaches each job level.
+struct PromotionOdds {
+    static const int LEVEL_COUNT = static_cast<int>(JobLevel::FELLOW) + 1;
+
+    int trials = 0;
+    int maxDays = 0;
+    // daysToReach[level][day] = trials that first reached level on that day
+    std::vector<std::vector<long long>> daysToReach;
+
+    PromotionOdds(int numTrials, int days)
+        : trials(numTrials), maxDays(days),
+          daysToReach(LEVEL_COUNT, std::vector<long long>(days + 1, 0)) {}
+
+    long long reached(JobLevel level) const {
+        long long total = 0;
+        for (long long count : daysToReach[static_cast<int>(level)]) total += count;
+        return total;
+    }
+
+    double probability(JobLevel level) const {
+        return trials > 0 ? static_cast<double>(reached(level)) / trials : 0.0;
+    }
+
+    // Mean days to reach a level, over the trials that reached it.
+    double meanDays(JobLevel level) const {
+        const auto& histogram = daysToReach[static_cast<int>(level)];
+        long long count = 0;
+        double sum = 0.0;
+        for (int day = 0; day <= maxDays; ++day) {
+            count += histogram[day];
+            sum += static_cast<double>(histogram[day]) * day;
+        }
+        return count > 0 ? sum / count : 0.0;
+    }
+
+    void merge(const PromotionOdds& other) {
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            for (int day = 0; day <= maxDays; ++day) {
+                daysToReach[level][day] += other.daysToReach[level][day];
+            }
+        }
+    }
+};
+
+// Monte Carlo estimate of how quickly a character climbs the job ladder.
+// Each worker thread owns a headless game with its own RNG stream and
+// replays independent trials from a copy of the starting character, so the
+// workers share nothing until their histograms are merged.
+class PromotionOddsEstimator {
+private:
+    Character start;
+    ActivityPolicy policy;
+
+    // Runs trials [firstTrial, endTrial). Trial n always rolls from dice
+    // stream n, so the totals do not depend on how trials are split up.
+    static void runTrials(const Character& start, const ActivityPolicy& policy, int firstTrial,
+                          int endTrial, int maxDays, uint64_t seed, PromotionOdds& odds) {
+        ReproducibleMeetingGame game(true, seed);
+        const int startLevel = static_cast<int>(start.getJobLevel());
+        for (int trial = firstTrial; trial < endTrial; ++trial) {
+            game.resetRoster();
+            game.setRollStream(static_cast<uint32_t>(trial));
+            game.addCharacter(start);
+            int levelReached = startLevel;
+            for (int day = 1; day <= maxDays && levelReached < PromotionOdds::LEVEL_COUNT - 1; ++day) {
+                policy(game, 0);
+                int level = static_cast<int>(game.getCharacter(0).getJobLevel());
+                for (; levelReached < level; ++levelReached) {
+                    odds.daysToReach[levelReached + 1][day]++;
+                }
+                game.nextDay();
+            }
+        }
+    }
+
+public:
+    PromotionOddsEstimator(const Character& character, ActivityPolicy activityPolicy)
+        : start(character), policy(std::move(activityPolicy)) {}
+
+    // The result depends only on the arguments other than threads.
+    PromotionOdds estimate(int trials, int maxDays, uint64_t seed, int threads = 0) const {
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::max(1, std::min(threads, trials));
+
+        std::vector<PromotionOdds> partials(threads, PromotionOdds(0, maxDays));
+        std::vector<std::thread> workers;
+        int firstTrial = 0;
+        for (int t = 0; t < threads; ++t) {
+            int share = trials / threads + (t < trials % threads ? 1 : 0);
+            workers.emplace_back(runTrials, std::cref(start), std::cref(policy), firstTrial,
+                                 firstTrial + share, maxDays, seed, std::ref(partials[t]));
+            firstTrial += share;
+        }
+
+        PromotionOdds odds(trials, maxDays);
+        for (int t = 0; t < threads; ++t) {
+            workers[t].join();
+            odds.merge(partials[t]);
+        }
+        return odds;
+    }
+};
+
+// Totals over every character of a SimulationRunner run.
+struct SimulationStats {
+    static const int LEVEL_COUNT = PromotionOdds::LEVEL_COUNT;
+
+    long long orgs = 0;
+    long long characters = 0;
+    long long characterDays = 0;
+    long long experience = 0;            // gained during the run
+    long long reached[LEVEL_COUNT] = {}; // characters that ended at or above each level
+
+    void merge(const SimulationStats& other) {
+        orgs += other.orgs;
+        characters += other.characters;
+        characterDays += other.characterDays;
+        experience += other.experience;
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            reached[level] += other.reached[level];
+        }
+    }
+
+    // Share of all characters that reached a level.
+    double reachRate(JobLevel level) const {
+        return characters > 0 ? static_cast<double>(reached[static_cast<int>(level)]) / characters : 0.0;
+    }
+
+    // Share of the characters who reached a level that were promoted out
+    // of it.
+    double promotionRate(JobLevel level) const {
+        const int l = static_cast<int>(level);
+        if (l + 1 >= LEVEL_COUNT || reached[l] == 0) return 0.0;
+        return static_cast<double>(reached[l + 1]) / reached[l];
+    }
+
+    double meanXpPerDay() const {
+        return characterDays > 0 ? static_cast<double>(experience) / characterDays : 0.0;
+    }
+};
+
+// Simulates many independent orgs in one process, e.g. for what-if
+// analysis. Each org is a headless ReproducibleMeetingGame rolling from its
+// own dice stream, kept in its own cache-line aligned shard. Shards are
+// advanced a chunk of days at a time by a work-stealing pool: every worker
+// owns a queue, takes its newest shard first and steals the oldest from
+// another worker when it runs dry, sleeping while every remaining shard is
+// being worked on. The statistics depend only on the orgs
+// and the seed, not on the thread count or on scheduling.
+class SimulationRunner {
+private:
+    struct alignas(64) Shard {
+        ReproducibleMeetingGame game;
+        int daysLeft;
+        bool finished = false;
+        SimulationStats stats;
+
+        Shard(uint64_t seed, uint32_t stream, int members, int days) : game(true, seed), daysLeft(days) {
+            game.setRollStream(stream);
+            for (int i = 0; i < members; ++i) {
+                game.addCharacter("Member " + std::to_string(i + 1));
+            }
+            stats.orgs = 1;
+            stats.characters = members;
+            stats.characterDays = static_cast<long long>(members) * days;
+        }
+    };
+
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<size_t> shards; // the owner works at the back, thieves take the front
+    };
+
+    // What the workers share: their queues, and the counts that idle
+    // workers sleep on until there is a shard to take or none is left.
+    struct Schedule {
+        std::vector<WorkQueue> queues;
+        std::mutex mutex;
+        std::condition_variable changed;
+        size_t queued = 0;     // shards waiting in the queues
+        size_t unfinished = 0; // shards with days left to simulate
+
+        explicit Schedule(int threads) : queues(threads) {}
+    };
+
+    ActivityPolicy policy;
+    uint64_t seed;
+    int chunkDays;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    void advance(Shard& shard, int days) const {
+        ReproducibleMeetingGame& game = shard.game;
+        for (int day = 0; day < days; ++day) {
+            for (int i = 0; i < game.getCharacterCount(); ++i) {
+                policy(game, i);
+            }
+            game.nextDay();
+        }
+        shard.daysLeft -= days;
+        if (shard.daysLeft == 0 && !shard.finished) {
+            shard.finished = true;
+            for (const Character& character : game.getCharacters()) {
+                shard.stats.experience += character.getExperience();
+                for (int level = 0; level <= static_cast<int>(character.getJobLevel()); ++level) {
+                    shard.stats.reached[level]++;
+                }
+            }
+        }
+    }
+
+    bool takeQueued(std::vector<WorkQueue>& queues, int worker, size_t& shard) const {
+        {
+            WorkQueue& own = queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.shards.empty()) {
+                shard = own.shards.back();
+                own.shards.pop_back();
+                return true;
+            }
+        }
+        for (size_t k = 1; k < queues.size(); ++k) {
+            WorkQueue& victim = queues[(worker + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.shards.empty()) {
+                shard = victim.shards.front();
+                victim.shards.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool take(Schedule& schedule, int worker, size_t& shard) const {
+        if (!takeQueued(schedule.queues, worker, shard)) return false;
+        std::lock_guard<std::mutex> lock(schedule.mutex);
+        schedule.queued--;
+        return true;
+    }
+
+    void work(Schedule& schedule, int worker) const {
+        size_t index;
+        while (true) {
+            if (!take(schedule, worker, index)) {
+                std::unique_lock<std::mutex> lock(schedule.mutex);
+                schedule.changed.wait(lock, [&] { return schedule.queued > 0 || schedule.unfinished == 0; });
+                if (schedule.unfinished == 0) return;
+                continue;
+            }
+            Shard& shard = *shards[index];
+            advance(shard, std::min(chunkDays, shard.daysLeft));
+            if (shard.daysLeft > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(schedule.queues[worker].mutex);
+                    schedule.queues[worker].shards.push_back(index);
+                }
+                {
+                    std::lock_guard<std::mutex> lock(schedule.mutex);
+                    schedule.queued++;
+                }
+                schedule.changed.notify_one();
+            } else {
+                bool allDone;
+                {
+                    std::lock_guard<std::mutex> lock(schedule.mutex);
+                    allDone = --schedule.unfinished == 0;
+                }
+                if (allDone) schedule.changed.notify_all();
+            }
+        }
+    }
+
+public:
+    SimulationRunner(ActivityPolicy activityPolicy, uint64_t runSeed, int daysPerChunk = 30)
+        : policy(std::move(activityPolicy)), seed(runSeed), chunkDays(std::max(1, daysPerChunk)) {}
+
+    // Adds an org of new hires to be simulated for the given number of days.
+    void addOrg(int members, int days) {
+        shards.emplace_back(new Shard(seed, static_cast<uint32_t>(shards.size()), members, std::max(0, days)));
+    }
+
+    size_t getOrgCount() const { return shards.size(); }
+
+    // Runs every org to the end of its days and sums their statistics.
+    SimulationStats run(int threads = 0) {
+        if (threads <= 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        Schedule schedule(threads);
+        for (size_t i = 0; i < shards.size(); ++i) {
+            if (shards[i]->daysLeft > 0) {
+                schedule.queues[i % threads].shards.push_back(i);
+                schedule.queued++;
+                schedule.unfinished++;
+            } else {
+                advance(*shards[i], 0); // simulated for zero days
+            }
+        }
+
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; ++t) {
+            workers.emplace_back(&SimulationRunner::work, this, std::ref(schedule), t);
+        }
+        work(schedule, 0);
+        for (auto& worker : workers) worker.join();
+
+        SimulationStats total;
+        for (const auto& shard : shards) {
+            total.merge(shard->stats);
+        }
+        return total;
+    }
+};
+
+// Build with -DSDEWG_NO_MAIN to reuse the engine from another entry point,
+// e.g. the benchmark suite in sdewg_bench.cpp.
+#ifndef SDEWG_NO_MAIN
+int main(int argc, char* argv[]) {
+    // Every mode takes --seed <n> to replay a run; without it the dice are
+    // seeded from std::random_device.
+    uint64_t seed = std::random_device{}();
+
+    // Every mode also takes --metrics <file>: the engine metrics are written
+    // there in Prometheus text format every few seconds and on exit.
+    std::vector<char*> args;
+    std::string metricsFile;
+    for (int i = 0; i < argc; ++i) {
+        if (std::string(argv[i]) == "--metrics" && i + 1 < argc) {
+            metricsFile = argv[++i];
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    argc = static_cast<int>(args.size());
+    argv = args.data();
+#ifndef SDEWG_NO_METRICS
+    std::unique_ptr<MetricsExporter> metrics;
+    if (!metricsFile.empty()) {
+        metrics.reset(new MetricsExporter(metricsFile, std::chrono::seconds(5)));
+    }
+#else
+    if (!metricsFile.empty()) {
+        std::cerr << "Warning: built with SDEWG_NO_METRICS, --metrics ignored\n";
+    }
+#endif
+
+    // sdewg --headless [script] [--verbose | --events <file>] [--tasks <file>]
+    // [--seed <n>]: run a command script (default: stdin) with no terminal
+    // interaction. Events are discarded unless printed (--verbose) or
+    // recorded in binary form; --tasks replaces the built-in task catalog.
+    if (argc > 1 && std::string(argv[1]) == "--headless") {
+        std::string scriptFile;
+        std::string eventFile;
+        std::string taskFile;
+        bool verbose = false;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--verbose") {
+                verbose = true;
+            } else if (arg == "--events" && i + 1 < argc) {
+                eventFile = argv[++i];
+            } else if (arg == "--tasks" && i + 1 < argc) {
+                taskFile = argv[++i];
+            } else if (arg == "--seed" && i + 1 < argc) {
+                seed = std::strtoull(argv[++i], nullptr, 10);
+            } else {
+                scriptFile = arg;
+            }
+        }
+
+        MeetingGame game(true, seed);
+        std::unique_ptr<BinaryEventSink> eventLog;
+        if (verbose) {
+            game.setEventSink(consoleSink());
+        } else if (!eventFile.empty()) {
+            eventLog.reset(new BinaryEventSink(eventFile));
+            if (!eventLog->isOpen()) {
+                std::cerr << "Error: Could not create event log '" << eventFile << "'!\n";
+                return 1;
+            }
+            game.setEventSink(*eventLog);
+        }
+        if (!taskFile.empty() && !game.loadTaskCatalog(taskFile)) {
+            std::cerr << "Error: Could not load task catalog '" << taskFile << "'!\n";
+            return 1;
+        }
+        if (!scriptFile.empty()) {
+            std::ifstream script(scriptFile);
+            if (!script.is_open()) {
+                std::cerr << "Error: Could not open script '" << scriptFile << "'!\n";
+                return 1;
+            }
+            return game.runScript(script) ? 0 : 1;
+        }
+        return game.runScript(std::cin) ? 0 : 1;
+    }
+
+    // sdewg --plan [level] [--tasks <file>] [--threads <n>] [--script <file>]:
+    // plan the fastest expected path for a new hire to a job level (1-6,
+    // default Fellow) and optionally write it out as a --headless script.
+    if (argc > 1 && std::string(argv[1]) == "--plan") {
+        int level = static_cast<int>(JobLevel::FELLOW);
+        int threads = 0;
+        std::string taskFile;
+        std::string scriptFile;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--tasks" && i + 1 < argc) {
+                taskFile = argv[++i];
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = std::atoi(argv[++i]);
+            } else if (arg == "--script" && i + 1 < argc) {
+                scriptFile = argv[++i];
+            } else {
+                level = std::atoi(arg.c_str());
+            }
+        }
+        if (level < 1 || level > static_cast<int>(JobLevel::FELLOW)) {
+            std::cerr << "Error: Job level must be 1-" << static_cast<int>(JobLevel::FELLOW) << "!\n";
+            return 1;
+        }
+
+        TaskCatalog catalog = TaskCatalog::defaults();
+        if (!taskFile.empty()) {
+            std::ifstream in(taskFile);
+            std::string error;
+            if (!in.is_open() || !TaskCatalog::load(in, catalog, error)) {
+                std::cerr << "Error: Could not load task catalog '" << taskFile << "'! " << error << "\n";
+                return 1;
+            }
+        }
+        const Character candidate("Candidate");
+        const JobLevel target = static_cast<JobLevel>(level);
+        CareerPlan plan = CareerPlanner(catalog).plan(candidate, target, threads);
+        if (!plan.reachable) {
+            std::cout << Character::getJobLevelName(target) << " cannot be reached with these tasks.\n";
+            return 1;
+        }
+
+        const auto& tasks = catalog.getTasks();
+        std::cout << std::fixed << std::setprecision(1);
+        std::cout << "Fastest expected path to " << Character::getJobLevelName(target) << ": "
+                  << plan.expectedDays() << " days (" << plan.expectedActivities << " activities)\n";
+        for (const auto& stage : plan.stages) {
+            JobLevel next = static_cast<JobLevel>(static_cast<int>(stage.from) + 1);
+            std::cout << "\n" << Character::getJobLevelName(stage.from) << " -> "
+                      << Character::getJobLevelName(next) << ": "
+                      << stage.expectedActivities / Character::MAX_ACTIVITIES_PER_DAY << " days\n";
+            for (const auto& skillTarget : stage.skillTargets) {
+                std::cout << "  Train " << skillName(skillTarget.first) << " to " << skillTarget.second << "\n";
+            }
+            std::cout << "  Farm XP on " << tasks[stage.grindTask].name << "\n";
+            std::cout << "  Attempt " << catalog.promotionTaskFor(stage.from)->name << "\n";
+        }
+
+        if (!scriptFile.empty()) {
+            std::ofstream script(scriptFile);
+            if (!script.is_open()) {
+                std::cerr << "Error: Could not write script '" << scriptFile << "'!\n";
+                return 1;
+            }
+            script << "# " << Character::getJobLevelName(target) << " in " << plan.days.size()
+                   << " days along the expected path\n";
+            script << "add " << candidate.getName() << "\n";
+            plan.writeScript(script, 1);
+            std::cout << "\nDay-by-day script written to '" << scriptFile << "'\n";
+        }
+        return 0;
+    }
+
+    // sdewg --odds <days> <trials> [task | plan] [--seed <n>] [--threads <n>]:
+    // estimate how fast a new hire climbs the ladder, either training for
+    // promotion, repeating a task or following the --plan career plan. A
+    // given seed gives the same odds on any number of threads.
+    if (argc > 3 && std::string(argv[1]) == "--odds") {
+        int days = std::atoi(argv[2]);
+        int trials = std::atoi(argv[3]);
+        int threads = 0;
+        int task = 0;
+        bool planned = false;
+        for (int i = 4; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--seed" && i + 1 < argc) {
+                seed = std::strtoull(argv[++i], nullptr, 10);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = std::atoi(argv[++i]);
+            } else if (arg == "plan") {
+                planned = true;
+            } else {
+                task = std::atoi(arg.c_str());
+            }
+        }
+        if (days < 1 || trials < 1) {
+            std::cerr << "Error: Days and trials must be positive numbers!\n";
+            return 1;
+        }
+        ActivityPolicy policy = task > 0 ? repeatTaskPolicy(task - 1) : trainForPromotionPolicy();
+        if (planned) {
+            policy = plannedPolicy(CareerPlanner(*TaskCatalog::builtIn())
+                                       .plan(Character("Candidate"), JobLevel::FELLOW, threads));
+        }
+        PromotionOddsEstimator estimator(Character("Candidate"), policy);
+        PromotionOdds odds = estimator.estimate(trials, days, seed, threads);
+        std::cout << std::fixed << std::setprecision(2);
+        for (int level = 1; level < PromotionOdds::LEVEL_COUNT; ++level) {
+            JobLevel jl = static_cast<JobLevel>(level);
+            std::cout << std::setw(24) << std::left << Character::getJobLevelName(jl) << std::right
+                      << " reached: " << std::setw(6) << odds.probability(jl) * 100 << "%"
+                      << "  mean days: " << odds.meanDays(jl) << "\n";
+        }
+        return 0;
+    }
+
+    // sdewg --trend <archive> [day]: one line per day recorded in an archive
+    // (see the archive script command) with the team size, mean level,
+    // members eligible for promotion and members at each job level from
+    // Intern to Fellow; given a day, that day's team stats instead.
+    if (argc > 2 && std::string(argv[1]) == "--trend") {
+        const std::string filename = argv[2];
+        if (argc > 3) {
+            std::vector<Character> team;
+            std::string error;
+            if (!SaveArchive::read(filename, std::atoi(argv[3]), team, error)) {
+                std::cerr << "Error: " << error << "!\n";
+                return 1;
+            }
+            for (const auto& character : team) character.displayStats();
+            return 0;
+        }
+
+        SaveArchive::Reader reader(filename);
+        if (!reader.isOpen()) {
+            std::cerr << "Error: " << reader.getError() << "!\n";
+            return 1;
+        }
+        using Row = SaveArchive::Row;
+        std::cout << "  Day   Team  Mean level  Eligible  By job level\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (int day : reader.days()) {
+            if (!reader.seek(day)) {
+                std::cerr << "Error: " << reader.getError() << "!\n";
+                return 1;
+            }
+            const auto& rows = reader.getRows();
+            std::array<int, static_cast<int>(JobLevel::FELLOW) + 1> byJobLevel{};
+            double levels = 0.0;
+            int eligible = 0;
+            for (const Row& row : rows) {
+                levels += row.fields[Row::LEVEL];
+                eligible += row.fields[Row::ELIGIBLE] != 0;
+                const int32_t jobLevel = row.fields[Row::JOB_LEVEL];
+                if (jobLevel >= 0 && jobLevel < static_cast<int32_t>(byJobLevel.size())) byJobLevel[jobLevel]++;
+            }
+            std::cout << std::setw(5) << day << std::setw(7) << rows.size() << std::setw(12)
+                      << (rows.empty() ? 0.0 : levels / rows.size()) << std::setw(10) << eligible << " ";
+            for (int count : byJobLevel) std::cout << " " << count;
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    // sdewg --orgs <orgs> <members> <days> [--seed <n>] [--threads <n>]:
+    // simulate many orgs of new hires training for promotion, in parallel,
+    // and report how far they got.
+    if (argc > 4 && std::string(argv[1]) == "--orgs") {
+        int orgs = std::atoi(argv[2]);
+        int members = std::atoi(argv[3]);
+        int days = std::atoi(argv[4]);
+        int threads = 0;
+        for (int i = 5; i + 1 < argc; i += 2) {
+            std::string arg = argv[i];
+            if (arg == "--seed") seed = std::strtoull(argv[i + 1], nullptr, 10);
+            else if (arg == "--threads") threads = std::atoi(argv[i + 1]);
+        }
+        SimulationRunner runner(trainForPromotionPolicy(), seed);
+        for (int org = 0; org < orgs; ++org) {
+            runner.addOrg(members, days);
+        }
+        SimulationStats stats = runner.run(threads);
+        std::cout << stats.orgs << " orgs, " << stats.characters << " characters, "
+                  << days << " days\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (int level = 0; level < SimulationStats::LEVEL_COUNT; ++level) {
+            JobLevel jl = static_cast<JobLevel>(level);
+            std::cout << std::setw(24) << std::left << Character::getJobLevelName(jl) << std::right
+                      << " reached: " << std::setw(6) << stats.reachRate(jl) * 100 << "%";
+            if (level + 1 < SimulationStats::LEVEL_COUNT) {
+                std::cout << "  promoted on: " << std::setw(6) << stats.promotionRate(jl) * 100 << "%";
+            }
+            std::cout << "\n";
+        }
+        std::cout << "Mean XP per day: " << stats.meanXpPerDay() << "\n";
+        return 0;
+    }
+
+    // sdewg [--tasks <file>] [--seed <n>]: interactive game, optionally with
+    // a custom task catalog
+    std::string taskFile;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--tasks") taskFile = argv[i + 1];
+        else if (arg == "--seed") seed = std::strtoull(argv[i + 1], nullptr, 10);
+    }
+    MeetingGame game(false, seed);
+    if (!taskFile.empty() && !game.loadTaskCatalog(taskFile)) {
+        return 1;
+    }
     game.runGame();
     return 0;
-}
\ No newline at end of file
+}
+#endif
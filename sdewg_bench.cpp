@@ -0,0 +1,255 @@
+// Microbenchmarks for the core game operations.
+//
+// Build: g++ -std=c++17 -O2 sdewg_bench.cpp -o sdewg_bench
+// Usage: sdewg_bench [--max-roster N] [--min-time SECONDS] [--label TEXT] [--out FILE]
+//
+// Every benchmark runs at roster sizes 1, 10, ... up to --max-roster
+// (default 1000000) and reports ns/op, heap allocations per op and
+// throughput in items (characters, lines, indices) per second. Results are
+// also written as CSV (default sdewg_bench.csv); the label column, e.g. a
+// commit hash, lets runs from different commits be compared.
+#define SDEWG_NO_MAIN
+#include "sdewg.cpp"
+
+#include <chrono>
+#include <new>
+
+static uint64_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// GCC cannot see that the replacement operator new above uses malloc
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct BenchResult {
+    std::string name;
+    size_t roster;
+    uint64_t ops;
+    double nsPerOp;
+    double allocsPerOp;
+    double itemsPerSecond;
+};
+
+class BenchSuite {
+private:
+    double minSeconds;
+    std::vector<BenchResult> results;
+
+public:
+    explicit BenchSuite(double minTime) : minSeconds(minTime) {}
+
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+    // Times op(i) until minSeconds have been spent inside it. Each op
+    // processes itemsPerOp items. When resetEvery is non-zero, reset() runs
+    // (untimed) before every batch of that many ops, for operations that
+    // use up state such as daily activities.
+    template <typename Op, typename Reset>
+    void run(const std::string& name, size_t roster, double itemsPerOp,
+             uint64_t resetEvery, Op op, Reset reset) {
+        using Clock = std::chrono::steady_clock;
+        uint64_t ops = 0;
+        uint64_t allocations = 0;
+        double ns = 0.0;
+        uint64_t batch = resetEvery ? resetEvery : 1;
+        while (ns < minSeconds * 1e9) {
+            reset();
+            const uint64_t allocStart = allocationCount;
+            const auto start = Clock::now();
+            for (uint64_t i = 0; i < batch; ++i) {
+                op(ops + i);
+            }
+            const auto end = Clock::now();
+            allocations += allocationCount - allocStart;
+            ns += std::chrono::duration<double, std::nano>(end - start).count();
+            ops += batch;
+            if (!resetEvery && batch < (1u << 20)) batch *= 2;
+        }
+
+        BenchResult result{name, roster, ops, ns / ops,
+                           static_cast<double>(allocations) / ops,
+                           itemsPerOp * ops / (ns / 1e9)};
+        std::cout << std::left << std::setw(28) << name << std::right
+                  << std::setw(9) << roster
+                  << std::setw(14) << std::fixed << std::setprecision(1) << result.nsPerOp
+                  << std::setw(12) << std::setprecision(2) << result.allocsPerOp
+                  << std::setw(16) << std::setprecision(0) << result.itemsPerSecond << "\n";
+        results.push_back(result);
+    }
+
+    template <typename Op>
+    void run(const std::string& name, size_t roster, double itemsPerOp, Op op) {
+        run(name, roster, itemsPerOp, 0, op, [] {});
+    }
+
+    bool writeCsv(const std::string& filename, const std::string& label) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) return false;
+        file << "label,benchmark,roster,ops,ns_per_op,allocs_per_op,items_per_sec\n";
+        file << std::setprecision(6);
+        for (const auto& r : results) {
+            file << label << "," << r.name << "," << r.roster << "," << r.ops << ","
+                 << r.nsPerOp << "," << r.allocsPerOp << "," << r.itemsPerSecond << "\n";
+        }
+        return true;
+    }
+};
+
+// A mid-career character: eligible for promotion with every requirement
+// of the Intern -> Engineer 1 task met comfortably.
+Character benchCharacter(size_t i) {
+    Character character("Member " + std::to_string(i));
+    character.restoreState(250, 3, JobLevel::INTERN, true, 3, 0,
+                           std::vector<int>(CORE_SKILL_COUNT, 10));
+    character.setEventSink(nullSink());
+    return character;
+}
+
+void fillRoster(MeetingGame& game, size_t roster) {
+    game.resetRoster();
+    for (size_t i = 0; i < roster; ++i) {
+        game.addCharacter(benchCharacter(i));
+    }
+}
+
+void benchRosterSize(BenchSuite& suite, size_t n) {
+    const double items = static_cast<double>(n);
+    MeetingGame game(true, 12345);
+
+    // attemptTaskMultiple: the whole roster takes part in one activity
+    {
+        fillRoster(game, n);
+        std::vector<int> everyone(n);
+        for (size_t i = 0; i < n; ++i) everyone[i] = static_cast<int>(i);
+        suite.run("attemptTaskMultiple", n, items, 3,
+                  [&](uint64_t i) { game.attemptTaskMultiple(everyone, static_cast<int>(i % 8)); },
+                  [&] { game.nextDay(); });
+    }
+
+    // attemptTaskBatch: the roster split into teams of five, one schedule
+    {
+        fillRoster(game, n);
+        std::vector<ScheduledActivity> schedule;
+        for (size_t i = 0; i < n; i += 5) {
+            ScheduledActivity activity{{}, static_cast<int>(schedule.size() % 8)};
+            for (size_t j = i; j < std::min(n, i + 5); ++j) activity.participants.push_back(static_cast<int>(j));
+            schedule.push_back(activity);
+        }
+        std::vector<ActivityResult> results(schedule.size());
+        suite.run("attemptTaskBatch", n, items, 3,
+                  [&](uint64_t) { game.attemptTaskBatch(schedule, results); },
+                  [&] { game.nextDay(); });
+    }
+
+    // DiceRoller: one batch of rolls per roster member
+    {
+        DiceRoller dice(12345);
+        std::vector<int32_t> rolls(n);
+        suite.run("DiceRoller::roll[batch]", n, items,
+                  [&](uint64_t) { dice.roll(rolls.data(), n); });
+    }
+
+    // attemptPromotionTask: each eligible character tries once
+    suite.run("attemptPromotionTask", n, 1, n,
+              [&](uint64_t i) { game.attemptPromotionTask(static_cast<int>(i % n)); },
+              [&] { fillRoster(game, n); });
+
+    // removeCharacterAt: empty the roster from the front
+    suite.run("removeCharacterAt", n, 1, n,
+              [&](uint64_t) { game.removeCharacterAt(0); },
+              [&] { fillRoster(game, n); });
+
+    // advanceDays: fast-forward a month with the whole roster inactive
+    {
+        fillRoster(game, n);
+        suite.run("advanceDays[30]", n, items,
+                  [&](uint64_t) { game.advanceDays(30); });
+    }
+
+    // Character::newDay and applySkillDecay over the roster
+    {
+        std::vector<Character> roster;
+        for (size_t i = 0; i < n; ++i) roster.push_back(benchCharacter(i));
+        suite.run("Character::newDay", n, items, 5,
+                  [&](uint64_t) { for (auto& c : roster) c.newDay(); },
+                  [&] { for (auto& c : roster) c.useActivity(); });
+        suite.run("Character::applySkillDecay", n, items, 5,
+                  [&](uint64_t) { for (auto& c : roster) c.applySkillDecay(); },
+                  [&] { for (auto& c : roster) c.improveSkill(LEADERSHIP, 5); });
+
+        // Character::serialize and Character::deserialize
+        std::vector<std::string> lines(n);
+        suite.run("Character::serialize", n, items,
+                  [&](uint64_t) { for (size_t i = 0; i < n; ++i) lines[i] = roster[i].serialize(); });
+        suite.run("Character::deserialize", n, items,
+                  [&](uint64_t) { for (const auto& line : lines) Character::deserialize(line); });
+    }
+
+    // parseCharacterSelection: every member listed
+    {
+        fillRoster(game, n);
+        std::string selection;
+        for (size_t i = 1; i <= n; ++i) selection += std::to_string(i) + ",";
+        suite.run("parseCharacterSelection", n, items,
+                  [&](uint64_t) { game.parseCharacterSelection(selection); });
+    }
+
+    // saveGame and loadGame in both on-disk formats
+    {
+        fillRoster(game, n);
+        const std::string v1File = "sdewg_bench_v1.sav";
+        const std::string v2File = "sdewg_bench_v2.sav";
+        MeetingGame loader(true, 1);
+        suite.run("saveGame[v1]", n, items,
+                  [&](uint64_t) { game.saveGame(v1File, SaveFormat::TEXT_V1); });
+        suite.run("loadGame[v1]", n, items,
+                  [&](uint64_t) { loader.loadGame(v1File); });
+        suite.run("saveGame[v2]", n, items,
+                  [&](uint64_t) { game.saveGame(v2File, SaveFormat::BINARY_V2); });
+        suite.run("loadGame[v2]", n, items,
+                  [&](uint64_t) { loader.loadGame(v2File); });
+        std::remove(v1File.c_str());
+        std::remove(v2File.c_str());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxRoster = 1000000;
+    double minTime = 0.2;
+    std::string label = "local";
+    std::string outFile = "sdewg_bench.csv";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--max-roster") maxRoster = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (arg == "--min-time") minTime = std::atof(argv[i + 1]);
+        else if (arg == "--label") label = argv[i + 1];
+        else if (arg == "--out") outFile = argv[i + 1];
+        else {
+            std::cerr << "Unknown option '" << arg << "'\n";
+            return 1;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << "benchmark" << std::right << std::setw(9) << "roster"
+              << std::setw(14) << "ns/op" << std::setw(12) << "allocs/op" << std::setw(16) << "items/s\n";
+    BenchSuite suite(minTime);
+    for (size_t n = 1; n <= maxRoster; n *= 10) {
+        benchRosterSize(suite, n);
+    }
+
+    if (!suite.writeCsv(outFile, label)) {
+        std::cerr << "Error: Could not write results to '" << outFile << "'!\n";
+        return 1;
+    }
+    std::cout << "Results written to '" << outFile << "'\n";
+    return 0;
+}